@@ -0,0 +1,322 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Neuron.hpp"
+#include "HugePageAllocator.hpp"
+
+constexpr int connection_block (256); //!< Number of post-synaptic neurons whose random connections are drawn with the same generator
+constexpr int max_delay (255); //!< Largest delay of a connection in time steps, the delays are stored on 8 bits
+
+/*!
+     * @class Connectivity
+     * @details This class stores the connections of the network in a compressed sparse row structure.
+     * The targets of all the neurons are stored one after the other in a single array, the targets of
+     * the neuron i are between the offsets i and i+1.
+     * The indexes of the targets are stored on 16 bits when the network has less than 65536 neurons
+     * and on 32 bits otherwise, this takes 2 or 4 bytes per connection instead of a pointer of 8 bytes
+     * in a vector of each neuron.
+     * The structure is built once: the connections are first added (one by one or randomly) and then
+     * compressed by a counting sort on the pre-synaptic neuron. The targets of a neuron are always
+     * sorted by index, so the targets of a neuron that are in a given range of neurons are contiguous
+     * and can be found by a binary search.
+     * A Connectivity can also keep only the connections towards a range of post-synaptic neurons, for example
+     * the neurons of one process of a distributed simulation: the pre-synaptic neurons are still all the neurons
+     * of the network, but the targets are stored relative to the first neuron of the range and only the targets
+     * in the range take memory.
+     * Once built, the connections can receive a weight each (a float stored next to the targets, in the same order),
+     * for example to study the plasticity: the amplitude of the pre-synaptic population is then multiplied by the
+     * weight of the connection. Without weights nothing is stored and every weight is 1.
+     * In the same way the connections can receive their own delay in time steps (one byte per connection, between 1
+     * and max_delay), for example drawn from a distribution; without delays every connection has the delay D.
+     */
+
+class Connectivity
+{
+public:
+	/*!
+     * @brief The constructor of the class Connectivity.
+     * @details The structure is created empty and already built, every neuron has no target.
+     *
+     * @param nb_neurons : an integer indicating the number of neurons in the network
+     */
+	Connectivity(int nb_neurons = total_neurons);
+	/*!
+     * @brief The constructor of a Connectivity keeping the targets in a range of neurons.
+     * @details The indexes of the targets are stored on 16 bits when the range has less than 65536 neurons.
+     *
+     * @param nb_neurons : an integer indicating the number of neurons in the network
+     * @param first_target : an integer indicating the first neuron of the range of targets
+     * @param nb_targets : an integer indicating the number of neurons of the range of targets
+     */
+	Connectivity(int nb_neurons, int first_target, int nb_targets);
+
+	/*!
+     * @brief Get the number of neurons of the network.
+     *
+     * @return An integer nb_neurons_: the number of neurons
+     */
+	int getNumberNeurons() const;
+	/*!
+     * @brief Get the first neuron of the range of targets.
+     *
+     * @return An integer first_target_: the index of the first post-synaptic neuron, 0 for the whole network
+     */
+	int getFirstTarget() const;
+	/*!
+     * @brief Get the number of neurons of the range of targets.
+     *
+     * @return An integer nb_targets_: the number of post-synaptic neurons, nb_neurons_ for the whole network
+     */
+	int getNumberTargetNeurons() const;
+	/*!
+     * @brief Get the total number of connections of the network.
+     *
+     * @return An integer: the number of connections
+     */
+	std::size_t getNumberConnections() const;
+	/*!
+     * @brief Get the number of targets of one neuron.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @return An integer: the number of post-synaptic neurons
+     */
+	int getNumberTargets(int source) const;
+	/*!
+     * @brief Get one target of one neuron.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param k : an integer indicating which target is needed
+     * @return An integer: the index of the k-th post-synaptic neuron, relative to the first target
+     */
+	int getTarget(int source, int k) const;
+	/*!
+     * @brief Get the number of bytes used to store the connections.
+     *
+     * @return An integer: the size in bytes of the offsets and of the targets
+     */
+	std::size_t getMemory() const;
+	/*!
+     * @brief Know if the indexes of the targets are stored on 16 bits.
+     *
+     * @return A boolean: true if the range of targets has less than 65536 neurons
+     */
+	bool isNarrow() const;
+	/*!
+     * @brief Get the offsets of the targets of all the neurons
+     * @details The targets of the neuron i are between offsets[i] and offsets[i+1].
+     *
+     * @return A pointer on the first of the nb_neurons_+1 offsets
+     */
+	const std::size_t* getOffsets() const;
+	/*!
+     * @brief Get the array of the targets when they are stored on 16 bits
+     *
+     * @return A pointer on the first target, nullptr if the targets are stored on 32 bits
+     */
+	const std::uint16_t* getNarrowTargets() const;
+	/*!
+     * @brief Get the array of the targets when they are stored on 32 bits
+     *
+     * @return A pointer on the first target, nullptr if the targets are stored on 16 bits
+     */
+	const std::uint32_t* getWideTargets() const;
+	/*!
+     * @brief Know if the connections have their own weights.
+     *
+     * @return A boolean: true if addWeights has been called
+     */
+	bool hasWeights() const;
+	/*!
+     * @brief Get the weight of the k-th connection of a neuron.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param k : an integer indicating the index of the connection among the targets of the neuron
+     * @return A float: the weight of the connection, 1 without weights
+     */
+	float getWeight(int source, int k) const;
+	/*!
+     * @brief Get the array of the weights, in the order of the targets
+     *
+     * @return A pointer on the first weight, nullptr if the connections have no weights
+     */
+	const float* getWeights() const;
+	/*!
+     * @brief Know if the connections have their own delays.
+     *
+     * @return A boolean: true if addDelays or addRandomDelays has been called
+     */
+	bool hasDelays() const;
+	/*!
+     * @brief Get the delay of the k-th connection of a neuron.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param k : an integer indicating the index of the connection among the targets of the neuron
+     * @return An integer: the delay in time steps, D without delays
+     */
+	int getDelay(int source, int k) const;
+	/*!
+     * @brief Get the array of the delays, in the order of the targets
+     *
+     * @return A pointer on the first delay, nullptr if the connections have no delays
+     */
+	const std::uint8_t* getDelays() const;
+	/*!
+     * @brief Get the smallest delay of the connections, which limits the number of time steps updated before
+     * the spikes are sent.
+     *
+     * @return An integer: the delay in time steps, D without delays or without connections
+     */
+	int getMinDelay() const;
+	/*!
+     * @brief Get the largest delay of the connections, which gives the number of boxes of the time buffers.
+     *
+     * @return An integer: the delay in time steps, D without delays or without connections
+     */
+	int getMaxDelay() const;
+
+	/*!
+     * @brief Add one connection between two neurons.
+     * @details The connection is kept aside until build is called.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param target : an integer indicating the index of the post-synaptic neuron
+     */
+	void addConnection(int source, int target);
+	/*!
+     * @brief Compress all the connections added in the structure.
+     * @details The connections are sorted by pre-synaptic neuron with a counting sort, then
+     * the targets of each neuron are sorted. The connections already present are kept.
+     */
+	void build();
+	/*!
+     * @brief Create the random connections of the Brunel's network and build the structure.
+     * @details Every neuron receives conn_e connections from excitatory neurons and
+     * conn_i connections from inhibitory neurons, chosen randomly as in Neuron::addConnections.
+     * The excitatory neurons are the first nb_excitatory neurons.
+     * Only the blocks containing the range of targets are drawn and only the connections towards the range are
+     * kept, they are the same as the connections of the whole network with the same seed.
+     * The post-synaptic neurons are divided in blocks of connection_block neurons and each block draws its
+     * pre-synaptic neurons with its own generator, seeded by the seed and the index of the block, so the blocks
+     * are drawn in parallel and the connections depend only on the seed, not on the number of threads.
+     * The structure is built by a parallel counting sort: the random numbers are drawn twice, the first time
+     * to count the targets of each neuron in each group of blocks, the second time to store them at their
+     * position, so that no list of pairs is needed.
+     *
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons
+     * @param conn_e : an integer indicating the number of excitatory connections received by each neuron
+     * @param conn_i : an integer indicating the number of inhibitory connections received by each neuron
+     * @param seed : a positive integer used as seed for the random generators
+     * @param nb_threads : an integer indicating the number of threads drawing the connections
+     */
+	void addRandomConnections(int nb_excitatory, int conn_e, int conn_i, unsigned int seed, int nb_threads = 1);
+	/*!
+     * @brief Give the same weight to every connection built.
+     * @details The weights are stored from now on, no connection can be added after.
+     *
+     * @param weight : a float indicating the weight of all the connections
+     */
+	void addWeights(float weight = 1.0f);
+	/*!
+     * @brief Set the weight of the k-th connection of a neuron, after addWeights.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param k : an integer indicating the index of the connection among the targets of the neuron
+     * @param weight : a float indicating the new weight
+     */
+	void setWeight(int source, int k, float weight);
+	/*!
+     * @brief Give the same delay to every connection built.
+     * @details The delays are stored from now on, no connection can be added after.
+     *
+     * @param delay : an integer indicating the delay of all the connections in time steps (between 1 and max_delay)
+     */
+	void addDelays(int delay = D);
+	/*!
+     * @brief Give to every connection built a delay drawn uniformly between two delays.
+     * @details The delays are drawn in the order of the connections, so they depend only on the seed.
+     *
+     * @param shortest : an integer indicating the smallest delay in time steps (at least 1)
+     * @param longest : an integer indicating the largest delay in time steps (at most max_delay)
+     * @param seed : a positive integer used as seed for the random generator
+     */
+	void addRandomDelays(int shortest, int longest, unsigned int seed);
+	/*!
+     * @brief Set the delay of the k-th connection of a neuron, after addDelays.
+     *
+     * @param source : an integer indicating the index of the pre-synaptic neuron
+     * @param k : an integer indicating the index of the connection among the targets of the neuron
+     * @param delay : an integer indicating the new delay in time steps (between 1 and max_delay)
+     */
+	void setDelay(int source, int k, int delay);
+
+	/*!
+     * @brief Replace the structure by connections already built, for example read in a checkpoint.
+     *
+     * @param offsets : the nb_neurons+1 offsets of the targets of each neuron
+     * @param targets : the targets, on 16 bits if the network is narrow and on 32 bits otherwise
+     * @param weights : the weights in the order of the targets, nullptr if the connections have no weights
+     * @param delays : the delays in the order of the targets, nullptr if the connections have no delays
+     */
+	void assign(const std::size_t* offsets, const void* targets, const float* weights = nullptr,
+				const std::uint8_t* delays = nullptr);
+
+	/*!
+     * @brief The destructor of the class Connectivity
+     */
+	~Connectivity();
+
+private:
+	/*!
+     * @brief Draw the pre-synaptic neurons of the post-synaptic neurons of one block
+     * @details The generator of the block is created from the seed and the index of the block.
+     *
+     * @param block : an integer indicating the index of the block
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons
+     * @param conn_e : an integer indicating the number of excitatory connections received by each neuron
+     * @param conn_i : an integer indicating the number of inhibitory connections received by each neuron
+     * @param seed : a positive integer used as seed for the random generators
+     * @param connect : the function called with the pre-synaptic neuron and the target, relative to the first target, of each connection
+     */
+	template <typename Function>
+	void drawSources(int block, int nb_excitatory, int conn_e, int conn_i, unsigned int seed, Function const& connect) const;
+	/*!
+     * @brief Store the target of one connection at a given position
+     *
+     * @param position : an integer indicating the position in the array of targets
+     * @param target : an integer indicating the index of the post-synaptic neuron
+     */
+	void setTarget(std::size_t position, int target);
+	/*!
+     * @brief Sort the targets of each neuron by index
+     */
+	void sortTargets();
+	/*!
+     * @brief Allocate the array of targets once the offsets are known
+     */
+	void allocateTargets();
+
+	int nb_neurons_; //!< Number of neurons of the network
+
+	int first_target_; //!< First neuron of the range of targets
+
+	int nb_targets_; //!< Number of neurons of the range of targets
+
+	LargeVector<std::size_t> offsets_; //!< Offsets of the targets of each neuron, nb_neurons_+1 values
+
+	LargeVector<std::uint16_t> narrow_targets_; //!< Targets when the network has less than 65536 neurons
+
+	LargeVector<std::uint32_t> wide_targets_; //!< Targets of the bigger networks
+
+	LargeVector<float> weights_; //!< Weights of the connections in the order of the targets, empty without weights
+
+	LargeVector<std::uint8_t> delays_; //!< Delays of the connections in time steps in the order of the targets, empty without delays
+
+	LargeVector<std::uint32_t> pending_sources_; //!< Pre-synaptic neurons of the connections not yet built
+
+	LargeVector<std::uint32_t> pending_targets_; //!< Post-synaptic neurons of the connections not yet built
+};
+
+#endif
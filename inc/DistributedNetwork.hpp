@@ -0,0 +1,212 @@
+#ifndef DISTRIBUTEDNETWORK_H
+#define DISTRIBUTEDNETWORK_H
+
+#include <vector>
+#include <random>
+#include <memory>
+#include "Network.hpp"
+#include "Transport.hpp"
+
+/*!
+     * @class DistributedNetwork
+     * @details This class simulates one part of a network divided between several processes (ranks).
+     * The partitions of partition_size neurons are divided in contiguous ranges, one per rank, and each rank
+     * keeps the arrays of its own neurons only: membrane potentials, refractory counters, spike states,
+     * number of spikes and time buffers. The connections are drawn by each rank from the seed, only towards
+     * its own neurons (see Connectivity), so no rank holds the connections of the whole network.
+     * The neurons are updated as in Network, by the same membrane kernel, and the noise of a neuron depends
+     * only on the seed, its index in the whole network and the time step. After each window of up to D time steps
+     * the ranks exchange all their spikes through a Transport and each rank sends the amplitudes of all the spikes
+     * to its own neurons. The amplitudes are added in the same order as in Network, so the simulation gives
+     * exactly the same result as a Network with the same seeds, for any number of ranks and of threads.
+     */
+
+class DistributedNetwork
+{
+public:
+	/*!
+     * @brief The constructor of the class DistributedNetwork.
+     * @details The arrays of the neurons of the rank are allocated, no connections are created here.
+     *
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons of the whole network
+     * @param nb_inhibitory : an integer indicating the number of inhibitory neurons of the whole network
+     * @param seed : a positive integer used as seed for the noises, the same for all the ranks
+     * @param transport : the communication between the ranks
+     */
+	DistributedNetwork(int nb_excitatory, int nb_inhibitory, unsigned int seed, std::shared_ptr<Transport> transport);
+
+	/*!
+     * @brief Get the number of neurons of the whole network.
+     *
+     * @return An integer nb_neurons_: the number of neurons
+     */
+	int getNumberNeurons() const;
+	/*!
+     * @brief Get the first neuron of this rank.
+     *
+     * @return An integer first_: the index of the first neuron in the whole network
+     */
+	int getFirstNeuron() const;
+	/*!
+     * @brief Get the number of neurons of this rank.
+     *
+     * @return An integer nb_local_: the number of neurons
+     */
+	int getNumberLocalNeurons() const;
+	/*!
+     * @brief Get the membrane potential of one neuron of this rank.
+     *
+     * @param i : an integer indicating the index of the neuron in the whole network
+     * @return A double: the membrane potential
+     */
+	double getV_membrane(int i) const;
+	/*!
+     * @brief Get the number of spikes of one neuron of this rank.
+     *
+     * @param i : an integer indicating the index of the neuron in the whole network
+     * @return A positive integer: the number of spikes
+     */
+	unsigned int getNumberSpikes(int i) const;
+	/*!
+     * @brief Know if one neuron of this rank is in its refractory period.
+     *
+     * @param i : an integer indicating the index of the neuron in the whole network
+     * @return A boolean: true if the neuron is in its refractory period
+     */
+	bool getRefractoryState(int i) const;
+	/*!
+     * @brief Get the clock of the network.
+     *
+     * @return A positive integer clock_: the time in time steps
+     */
+	unsigned int getClock() const;
+	/*!
+     * @brief Get the connections towards the neurons of this rank.
+     *
+     * @return A pointer connectivity_: the connections
+     */
+	std::shared_ptr<const Connectivity> getConnectivity() const;
+	/*!
+     * @brief Get the spikes of the whole network during the last update.
+     * @details Every rank knows all the spikes after the exchange. They are added sorted by time step and by neuron.
+     *
+     * @param spikes : a vector of spikes which receives the spikes of the last update
+     */
+	void getSpikes(std::vector<Spike>& spikes) const;
+	/*!
+     * @brief Get the list of the spikes of the whole network during the last update, without copying it.
+     *
+     * @return A vector spikes_: the spikes of the last update, valid until the next update
+     */
+	std::vector<Spike> const& getLastSpikes() const;
+
+	/*!
+     * @brief Set the external input received by all the neurons.
+     *
+     * @param external_input : a double indicating the external input
+     */
+	void setExternalInput(double external_input);
+	/*!
+     * @brief Set the amplitude of the spikes of the excitatory neurons and of the noises.
+     *
+     * @param J : a double indicating the amplitude in millivolts
+     */
+	void setAmplitude(double J);
+	/*!
+     * @brief Set the number of threads updating the neurons of this rank.
+     *
+     * @param nb_threads : an integer indicating the number of threads (at least 1)
+     */
+	void setNumberThreads(int nb_threads);
+	/*!
+     * @brief Add the random connections towards the neurons of this rank.
+     * @details They are the connections of Network::addConnections with the same seed.
+     *
+     * @param seed : a positive integer used as seed for the choice of the connections, the same for all the ranks
+     * @param conn_e : an integer indicating the number of excitatory connections received by each neuron
+     * @param conn_i : an integer indicating the number of inhibitory connections received by each neuron
+     */
+	void addConnections(unsigned int seed, int conn_e = c_e, int conn_i = c_i);
+	/*!
+     * @brief Update the neurons of this rank during one or several time steps and exchange the spikes.
+     * @details All the ranks must call it with the same parameters: it returns when the spikes of all the ranks
+     * have been received.
+     *
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the mean of the poisson generator of the noises, no noise if it's 0
+     * @param nb_steps : an integer indicating the number of time steps, between 1 and D
+     */
+	void update(double g, double pois, int nb_steps = 1);
+
+	/*!
+     * @brief The destructor of the class DistributedNetwork
+     */
+	~DistributedNetwork();
+
+private:
+	/*!
+     * @brief Update the neurons of one partition of this rank during several time steps (see ::updatePartition)
+     *
+     * @param p : an integer indicating the index of the partition in the rank
+     * @param nb_steps : an integer indicating the number of time steps
+     * @param noise : a boolean, false when there is no noise
+     */
+	void updatePartition(int p, int nb_steps, bool noise);
+	/*!
+     * @brief Send the amplitudes of all the spikes of the last update to the neurons of a group of partitions of this rank
+     * @details The spikes are delivered as in Network (see ::deliverSpikes), with the weights and the delays
+     * of the connections.
+     *
+     * @param group : an integer indicating the index of the group receiving the spikes
+     * @param nb_groups : an integer indicating the number of groups, the partitions are divided in contiguous groups
+     * @param ampl_e : a double indicating the amplitude of the spikes of the excitatory neurons
+     * @param ampl_i : a double indicating the amplitude of the spikes of the inhibitory neurons
+     */
+	void deliverGroup(int group, int nb_groups, double ampl_e, double ampl_i);
+
+	int nb_neurons_; //!< Number of neurons of the whole network
+
+	int nb_excitatory_; //!< Number of excitatory neurons of the whole network
+
+	int first_; //!< Index of the first neuron of this rank
+
+	int nb_local_; //!< Number of neurons of this rank
+
+	unsigned int clock_; //!< Clock of the network in time steps
+
+	double external_input_; //!< External input received by all the neurons
+
+	double amplitude_; //!< Amplitude J of the spikes of the excitatory neurons and of the noises
+
+	LargeVector<double> V_membrane_; //!< Membrane potentials of the neurons of this rank
+
+	LargeVector<std::uint8_t> refractory_; //!< Refractory counters of the neurons of this rank
+
+	LargeVector<char> spike_; //!< Spike states of the neurons of this rank
+
+	LargeVector<unsigned int> nb_spikes_; //!< Number of spikes of the neurons of this rank
+
+	LargeVector<float> t_buffer_; //!< Time buffers of the neurons of this rank, D+1 boxes of nb_local_ values
+
+	std::vector<std::size_t> rows_; //!< First value of the box of each time step modulo D+1, 2*D+1 values
+
+	std::shared_ptr<const Connectivity> connectivity_; //!< Connections towards the neurons of this rank
+
+	std::shared_ptr<Transport> transport_; //!< Communication with the other ranks
+
+	std::unique_ptr<ThreadPool> pool_; //!< Threads updating the partitions of this rank
+
+	MembraneKernel kernel_; //!< Kernel updating the neurons of a partition during one time step
+
+	PoissonGenerator noise_; //!< Generator of the number of external spikes received by the neurons
+
+	std::vector<std::vector<Spike> > partition_spikes_; //!< Spikes of each partition of this rank during the last update
+
+	std::vector<Spike> sent_; //!< Spikes of this rank during the last update, sent to the other ranks
+
+	std::vector<Spike> spikes_; //!< Spikes of the whole network during the last update, sorted by time step
+
+	std::vector<std::vector<std::size_t> > positions_; //!< Position of each spike in its targets, one vector per group
+};
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef EVENTNETWORK_H
+#define EVENTNETWORK_H
+
+#include <vector>
+#include <queue>
+#include <random>
+#include <memory>
+#include <cstdint>
+#include "Network.hpp"
+
+/*!
+     * @class EventNetwork
+     * @details This class simulates the same network as Network, but a neuron is updated only when
+     * something happens to it: when it receives an amplitude from another neuron or from the noise, or
+     * when it crosses the threshold. Between two events the membrane equation is a geometric decay towards
+     * the potential V_inf = const2*external_input/(1 - const1), so the potential after n time steps is computed
+     * directly: V_inf + (V - V_inf)*const1^n. Each neuron keeps its potential and the time step it was
+     * computed for (lazy state), and the time the neuron will cross the threshold without input, if it
+     * does (V_inf > V_thr), is computed in advance and kept in a queue of events.
+     * The delays are the same as in Network: the amplitudes are stored in the time buffers of the
+     * targets D time steps in advance, and the neurons receiving something at a time step are listed
+     * with their box. A neuron in its refractory period ignores what it receives.
+     * The noises are drawn for the whole network at once: the number of external spikes received by all
+     * the neurons during a time step follows a poisson distribution of mean nb_neurons*pois and each one is
+     * given to a neuron chosen randomly, which gives the same distribution as one poisson number per neuron.
+     * The cost of a simulation depends on the number of events and not on the number of neurons times the
+     * number of time steps, so the networks with few spikes and few noises are simulated much faster.
+     * The potentials are exact up to the rounding, they are not bit-identical to the ones of Network, which
+     * are computed step by step, and the noises are drawn differently, so the two networks give the same
+     * statistics but not the same spikes.
+     */
+
+class EventNetwork
+{
+public:
+	/*!
+     * @brief The constructor of the class EventNetwork.
+     * @details All the neurons start at 0 mV at t_start, no connections are created here.
+     *
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons
+     * @param nb_inhibitory : an integer indicating the number of inhibitory neurons
+     * @param seed : a positive integer used as seed for the noises
+     */
+	EventNetwork(int nb_excitatory = excitatory_neurons, int nb_inhibitory = inhibitory_neurons,
+				 unsigned int seed = std::random_device()());
+
+	/*!
+     * @brief Get the number of neurons of the network.
+     *
+     * @return An integer nb_neurons_: the number of neurons
+     */
+	int getNumberNeurons() const;
+	/*!
+     * @brief Get the membrane potential of one neuron at the current time step.
+     * @details The potential is computed from the last event of the neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A double: the membrane potential in millivolts
+     */
+	double getV_membrane(int i) const;
+	/*!
+     * @brief Get the number of spikes of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A positive integer nb_spikes_[i]: the number of spikes
+     */
+	unsigned int getNumberSpikes(int i) const;
+	/*!
+     * @brief Know if one neuron is in its refractory period.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A boolean: true if the neuron is still refractory at the current time step
+     */
+	bool getRefractoryState(int i) const;
+	/*!
+     * @brief Get the clock of the network.
+     *
+     * @return A positive integer clock_: the time in time steps
+     */
+	unsigned int getClock() const;
+	/*!
+     * @brief Get the number of events processed since the beginning.
+     * @details An event is the update of one neuron at one time step.
+     *
+     * @return A positive integer nb_events_: the number of events
+     */
+	std::uint64_t getNumberEvents() const;
+	/*!
+     * @brief Get the spikes of the last update.
+     *
+     * @param spikes : the vector where the spikes are added, sorted by time step and by neuron
+     */
+	void getSpikes(std::vector<Spike>& spikes) const;
+
+	/*!
+     * @brief Set the external input received by all the neurons.
+     *
+     * @param external_input : a double indicating the external input
+     */
+	void setExternalInput(double external_input);
+	/*!
+     * @brief Set the membrane potential of one neuron at the current time step.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param V_membrane : a double indicating the membrane potential in millivolts
+     */
+	void setV_membrane(int i, double V_membrane);
+	/*!
+     * @brief Set the amplitude of the spikes of the excitatory neurons and of the noises.
+     *
+     * @param J : a double indicating the amplitude in millivolts
+     */
+	void setAmplitude(double J);
+	/*!
+     * @brief Use connections already created.
+     *
+     * @param connectivity : the connections, with the same number of neurons as the network and without delays
+     */
+	void setConnectivity(std::shared_ptr<const Connectivity> connectivity);
+	/*!
+     * @brief Add the random connections between all the neurons, as Network::addConnections.
+     *
+     * @param seed : a positive integer used as seed for the choice of the connections
+     * @param conn_e : an integer indicating the number of excitatory connections received by each neuron
+     * @param conn_i : an integer indicating the number of inhibitory connections received by each neuron
+     */
+	void addConnections(unsigned int seed, int conn_e = c_e, int conn_i = c_i);
+
+	/*!
+     * @brief Update the network during one or several time steps.
+     * @details At each time step, the neurons crossing the threshold spike, then the neurons receiving
+     * amplitudes or noises are updated, the others are not touched. The spikes are sent to the targets
+     * at once, they are received D time steps later. At the end the clock advances of nb_steps time steps.
+     *
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the mean of the poisson generator of the noises, no noise if it's 0
+     * @param nb_steps : an integer indicating the number of time steps, at least 1
+     */
+	void update(double g, double pois, int nb_steps = 1);
+
+	/*!
+     * @brief The destructor of the class EventNetwork
+     */
+	~EventNetwork();
+
+private:
+	/*!
+     * @brief Compute the membrane potential of one neuron at a time step from its last event
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param step : a positive integer indicating the time step, not before the last event
+     * @return A double: the membrane potential at the beginning of the time step
+     */
+	double getPotential(int i, unsigned int step) const;
+	/*!
+     * @brief Find the time step one neuron crosses the threshold without input and add it to the queue
+     *
+     * @param i : an integer indicating the index of the neuron
+     */
+	void predictSpike(int i);
+	/*!
+     * @brief Make one neuron spike at a time step
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param step : a positive integer indicating the time step
+     */
+	void spike(int i, unsigned int step);
+	/*!
+     * @brief Store an amplitude received by one neuron at a time step
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param step : a positive integer indicating the time step the amplitude is read
+     * @param amplitude : a double indicating the amplitude in millivolts
+     */
+	void receive(int i, unsigned int step, double amplitude);
+
+	int nb_neurons_; //!< Number of neurons of the network
+
+	int nb_excitatory_; //!< Number of excitatory neurons, the first ones
+
+	unsigned int clock_; //!< Next time step to compute
+
+	double external_input_; //!< External input received by all the neurons
+
+	double amplitude_; //!< Amplitude J of the spikes of the excitatory neurons and of the noises
+
+	double V_inf_; //!< Potential reached by a neuron without input
+
+	LargeVector<double> V_membrane_; //!< Membrane potential of each neuron at the time step last_[i]
+
+	LargeVector<unsigned int> last_; //!< Time step of the potential of each neuron, the end of the refractory period after a spike
+
+	LargeVector<unsigned int> nb_spikes_; //!< Number of spikes of each neuron
+
+	LargeVector<unsigned int> predicted_; //!< Time step of the next spike of each neuron without input, the largest value if none
+
+	LargeVector<float> t_buffer_; //!< Time buffers of all the neurons, D+1 boxes of nb_neurons_ values
+
+	std::vector<std::vector<int>> received_; //!< Neurons having an amplitude in each box of the time buffers
+
+	LargeVector<unsigned int> listed_; //!< Time step of the last box each neuron is listed in, 0 if none
+
+	std::priority_queue<std::pair<unsigned int, int>, std::vector<std::pair<unsigned int, int>>,
+						std::greater<std::pair<unsigned int, int>>> crossings_; //!< Spikes without input, by time step
+
+	std::shared_ptr<const Connectivity> connectivity_; //!< Connections of the network
+
+	std::mt19937 gen_; //!< Random generator of the noises
+
+	std::uint64_t nb_events_; //!< Number of events processed
+
+	std::vector<Spike> spikes_; //!< Spikes of the last update
+};
+
+#endif
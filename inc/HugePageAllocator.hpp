@@ -0,0 +1,89 @@
+#ifndef HUGEPAGEALLOCATOR_H
+#define HUGEPAGEALLOCATOR_H
+
+#include <vector>
+#include <cstddef>
+
+constexpr std::size_t huge_page_size (2 << 20); //!< Size of a huge page in bytes, the allocations of this size or more are mapped
+
+/*!
+     * @brief Allocate a block of memory for a big array.
+     * @details A block of at least huge_page_size bytes is mapped directly, aligned on a huge page, and the kernel
+     * is asked to back it with huge pages when they are available (transparent huge pages), which reduces the
+     * misses of the TLB when the targets or the time buffers are read at random.
+     * The smaller blocks are allocated with the operator new.
+     *
+     * @param bytes : a positive integer indicating the size of the block in bytes
+     * @return A pointer on the block, std::bad_alloc is thrown if there isn't enough memory
+     */
+void* allocateLarge(std::size_t bytes);
+/*!
+     * @brief Release a block given by allocateLarge.
+     *
+     * @param block : a pointer on the block
+     * @param bytes : a positive integer indicating the size given to allocateLarge
+     */
+void releaseLarge(void* block, std::size_t bytes);
+
+/*!
+     * @class HugePageAllocator
+     * @details This allocator gives the memory of the big arrays of the network (the targets of the connections
+     * and the arrays of the neurons) with allocateLarge. Each array is one block released in one call when the
+     * network is destroyed, and the blocks of more than one huge page use huge pages when the system allows it.
+     */
+
+template <typename Value>
+class HugePageAllocator
+{
+public:
+	typedef Value value_type; //!< Type of the values allocated
+
+	/*!
+     * @brief The constructor of the class HugePageAllocator, the allocator has no state.
+     */
+	HugePageAllocator() = default;
+	/*!
+     * @brief The conversion from an allocator of another type.
+     */
+	template <typename Other>
+	HugePageAllocator(HugePageAllocator<Other> const&)
+	{}
+
+	/*!
+     * @brief Allocate an array.
+     *
+     * @param nb_values : a positive integer indicating the number of values
+     * @return A pointer on the first value
+     */
+	Value* allocate(std::size_t nb_values)
+	{
+		return static_cast<Value*>(allocateLarge(nb_values*sizeof(Value)));
+	}
+	/*!
+     * @brief Release an array.
+     *
+     * @param values : a pointer on the first value
+     * @param nb_values : a positive integer indicating the number of values given to allocate
+     */
+	void deallocate(Value* values, std::size_t nb_values)
+	{
+		releaseLarge(values, nb_values*sizeof(Value));
+	}
+};
+
+template <typename Value, typename Other>
+bool operator==(HugePageAllocator<Value> const&, HugePageAllocator<Other> const&)
+{
+	return true;
+}
+
+template <typename Value, typename Other>
+bool operator!=(HugePageAllocator<Value> const&, HugePageAllocator<Other> const&)
+{
+	return false;
+}
+
+template <typename Value>
+using LargeVector = std::vector<Value, HugePageAllocator<Value>>; //!< Vector of a big array of the network
+
+#endif
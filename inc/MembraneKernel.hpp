@@ -0,0 +1,85 @@
+#ifndef MEMBRANEKERNEL_H
+#define MEMBRANEKERNEL_H
+
+#include <string>
+#include <cstdint>
+
+/*!
+     * @struct MembraneBlock
+     * @details The arrays of a block of contiguous neurons updated by a membrane kernel during one time step.
+     * All the pointers point to the first neuron of the block.
+     */
+struct MembraneBlock
+{
+	double* V_membrane; //!< Membrane potentials
+
+	std::uint8_t* refractory; //!< Refractory counters, at most tau_rp
+
+	char* spike; //!< Spike states, 1 if the neuron spikes during this time step
+
+	unsigned int* nb_spikes; //!< Number of spikes of each neuron
+
+	float* box; //!< Boxes of the time buffers read during this time step (single precision), resetted to 0
+
+	const double* noise; //!< Amplitudes of the noises received during this time step
+
+	int size; //!< Number of neurons in the block
+
+	double input; //!< Input const2*external_input received by all the neurons
+};
+
+/*!
+     * @brief Function updating the neurons of a block during one time step.
+     * @details A neuron whose membrane potential is above the threshold spikes and stays in its refractory period
+     * during tau_rp time steps, exactly as in Neuron::update. The spiking neurons are written in the compact list
+     * spiking, which must have room for the whole block.
+     *
+     * @param block : the arrays of the neurons
+     * @param spiking : the indexes of the spiking neurons in the block, in increasing order
+     * @return An integer: the number of spiking neurons
+     */
+typedef int (*MembraneKernel)(MembraneBlock const& block, int* spiking);
+
+/*!
+     * @enum Instructions
+     * @details The instructions used by a membrane kernel: one neuron at a time, 4 neurons (AVX2)
+     * or 8 neurons (AVX-512) at a time. All the kernels give exactly the same result.
+     */
+enum class Instructions
+{
+	scalar, avx2, avx512
+};
+
+/*!
+ * @brief Know if the processor can execute some instructions.
+ *
+ * @param instructions : the instructions
+ * @return A boolean: true if the kernel using these instructions can be used
+ */
+bool isSupported(Instructions instructions);
+
+/*!
+ * @brief Get the fastest instructions supported by the processor.
+ *
+ * @return The instructions: AVX-512, AVX2 or scalar
+ */
+Instructions getBestInstructions();
+
+/*!
+ * @brief Get the name of some instructions.
+ *
+ * @param instructions : the instructions
+ * @return A string: scalar, avx2 or avx512
+ */
+std::string getName(Instructions instructions);
+
+/*!
+ * @brief Get the membrane kernel using some instructions.
+ * @details The instructions must be supported by the processor.
+ *
+ * @param instructions : the instructions
+ * @return The kernel
+ */
+MembraneKernel getMembraneKernel(Instructions instructions);
+
+#endif
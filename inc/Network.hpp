@@ -0,0 +1,451 @@
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include "Neuron.hpp"
+#include "Connectivity.hpp"
+#include "HugePageAllocator.hpp"
+#include "ThreadPool.hpp"
+#include "MembraneKernel.hpp"
+#include "PoissonGenerator.hpp"
+#include "Partition.hpp"
+
+/*!
+     * @struct CheckpointHeader
+     * @details Header at the beginning of a checkpoint file, which contains the whole state of a network.
+     * The header of 72 bytes is followed by the arrays of the network, each one padded to a multiple of 8 bytes:
+     * the membrane potentials (doubles), the refractory counters (bytes), the spike states (bytes),
+     * the number of spikes (unsigned integers on 32 bits), the time buffers (floats, delay+1 boxes of nb_neurons values),
+     * the offsets of the connections (unsigned integers on 64 bits, nb_neurons+1), the targets (16 or 32 bits), the weights
+     * of the connections (floats) if they have weights and their delays (bytes) if they have delays.
+     * The noises depend only on their seed and on the clock, so they don't have a state to save.
+     * The values are in the byte order of the computer.
+     */
+struct CheckpointHeader
+{
+	char magic[8]; //!< "BRUNELCK", identifies a checkpoint file
+	std::uint32_t version; //!< Version of the format, 7
+	std::uint32_t nb_neurons; //!< Number of neurons of the network
+	std::uint32_t nb_excitatory; //!< Number of excitatory neurons
+	std::uint32_t delay; //!< Largest delay in time steps, the time buffers have delay+1 boxes
+	std::uint32_t seed; //!< Seed of the noises
+	std::uint32_t narrow; //!< 1 if the targets are stored on 16 bits, 0 on 32 bits
+	std::uint64_t clock; //!< Clock of the network in time steps
+	std::uint64_t nb_connections; //!< Number of connections
+	double external_input; //!< External input received by all the neurons
+	double amplitude; //!< Amplitude J of the excitatory spikes and of the noises
+	std::uint32_t weighted; //!< 1 if the weights of the connections follow the targets, 0 otherwise
+	std::uint32_t delayed; //!< 1 if the delays of the connections follow the weights or the targets, 0 otherwise
+};
+
+/*!
+     * @class Network
+     * @details This class represents the whole Brunel's network as one engine.
+     * Instead of allocating every neuron separately, the network keeps each attribute of the
+     * neurons in its own contiguous array (structure of arrays): the membrane potentials,
+     * the refractory counters, the spike states, the number of spikes and the time buffers.
+     * The neuron i is the i-th element of every array. The first neurons are excitatory,
+     * the others are inhibitory. The connections are stored in a Connectivity, which can be
+     * shared between several networks because it is never modified by the network.
+     * The numbers of neurons are chosen at run time and the code isn't specialized for the default sizes:
+     * the loops already work on partitions of partition_size neurons known at compilation, and only
+     * the size of the indexes of the targets (16 bits below 65536 neurons) depends on the network.
+     * All the neurons share the same clock, so the whole population is updated
+     * in one loop at each time step.
+     * The semantic of the update is the same as Neuron::update: a neuron whose membrane potential
+     * is above the threshold spikes, sends the amplitude to its targets with a delay D and
+     * stays in its refractory period for tau_rp time steps. The connections can also have their own delays
+     * (see Connectivity): the time buffers then have one box more than the largest delay, chosen when the
+     * connections are set, and each connection writes in the box of its delay.
+     * The class Neuron remains for the single neuron simulations and the tests,
+     * a copy of one neuron of the network can be obtained with getNeuron.
+     * The neurons are divided in partitions of partition_size neurons, which can be updated
+     * in parallel by a pool of threads. The noises are drawn by a counter-based PoissonGenerator:
+     * the noise of a neuron at a time step depends only on the seed of the network, the index of the neuron
+     * and the time step, so the simulation gives exactly the same result for any number of threads.
+     * Because a spike is received after D time steps (the smallest delay), the neurons can be updated independently
+     * during up to D time steps before the spikes are sent to the targets (lookahead window).
+     * During one time step, the neurons of a partition are updated by a membrane kernel, which uses the vector
+     * instructions of the processor (AVX2 or AVX-512) when they are available: the threshold and the refractory
+     * period become masks and the kernel gives the compact list of the spiking neurons.
+     * The whole state of the network can be saved in a checkpoint file and restored later,
+     * to continue a simulation or to start several simulations from the same state.
+     */
+
+class Network
+{
+public:
+	/*!
+     * @brief The constructor of the class Network.
+     * @details All the arrays are allocated once. The membrane potentials, the refractory counters,
+     * the number of spikes and the time buffers are set to 0, no neuron has spiked and the clock
+     * of the network starts at t_start. No connections are created here.
+     *
+     * The network is updated by one thread.
+     *
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons
+     * @param nb_inhibitory : an integer indicating the number of inhibitory neurons
+     * @param seed : a positive integer used as seed for the noises
+     */
+	Network(int nb_excitatory = excitatory_neurons, int nb_inhibitory = inhibitory_neurons,
+			unsigned int seed = std::random_device()());
+
+	/*!
+     * @brief Get the number of neurons in the network.
+     *
+     * @return An integer nb_neurons_: the total number of neurons
+     */
+	int getNumberNeurons() const;
+	/*!
+     * @brief Get the number of excitatory neurons in the network.
+     * @details The excitatory neurons are the first ones of the network.
+     *
+     * @return An integer nb_excitatory_: the number of excitatory neurons
+     */
+	int getNumberExcitatory() const;
+	/*!
+     * @brief Get the membrane potential of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A double V_membrane_[i]: the membrane potential
+     */
+	double getV_membrane(int i) const;
+	/*!
+     * @brief Get the mean membrane potential of the neurons.
+     * @details The potentials of each partition are summed by the thread updating it, at the end of the update,
+     * so only the sums of the partitions are added here.
+     *
+     * @return A double: the mean of the membrane potentials in millivolts
+     */
+	double getMeanV_membrane() const;
+	/*!
+     * @brief Get the number of spikes done by one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A positive integer nb_spikes_[i]: the number of spikes
+     */
+	unsigned int getNumberSpikes(int i) const;
+	/*!
+     * @brief Get the spike state of one neuron, true if it has spiked during the last update.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A boolean: if the spike occured (true) or not (false)
+     */
+	bool getSpikeState(int i) const;
+	/*!
+     * @brief Get the refractory state of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A boolean: true if the neuron is in its refractory period
+     */
+	bool getRefractoryState(int i) const;
+	/*!
+     * @brief Get the instructions used to update the neurons.
+     *
+     * @return The instructions instructions_: scalar, AVX2 or AVX-512
+     */
+	Instructions getInstructions() const;
+	/*!
+     * @brief Get the amplitude of the spikes of the excitatory neurons and of the noises.
+     *
+     * @return A double amplitude_: the amplitude J in millivolts
+     */
+	double getAmplitude() const;
+	/*!
+     * @brief Get the amplitude stored in one box of the time buffer of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param box : an integer indicating the box of the time buffer (between 0 and getMaxDelay())
+     * @return A double: the amplitude stored
+     */
+	double getTimeBuffer(int i, int box) const;
+	/*!
+     * @brief Get the smallest delay of the connections, the largest window of update.
+     *
+     * @return An integer min_delay_: the delay in time steps
+     */
+	int getMinDelay() const;
+	/*!
+     * @brief Get the largest delay the time buffers can hold, they have one box more.
+     * @details It's the largest delay of the connections set, D at least, it doesn't decrease
+     * when the connections are replaced.
+     *
+     * @return An integer max_delay_: the delay in time steps
+     */
+	int getMaxDelay() const;
+	/*!
+     * @brief Get the connections of the network.
+     *
+     * @return A pointer connectivity_: the connections between the neurons
+     */
+	std::shared_ptr<const Connectivity> getConnectivity() const;
+	/*!
+     * @brief Get the clock of the network, common to all the neurons.
+     *
+     * @return A positive integer clock_: the time in time steps
+     */
+	unsigned int getClock() const;
+	/*!
+     * @brief Get the number of threads updating the network.
+     *
+     * @return An integer: the number of threads
+     */
+	int getNumberThreads() const;
+	/*!
+     * @brief Get the number of bytes used to store the state of the neurons.
+     * @details The membrane potentials, refractory counters, spike states, number of spikes and time buffers,
+     * without the connections (see Connectivity::getMemory).
+     *
+     * @return An integer: the size in bytes of the arrays of the neurons
+     */
+	std::size_t getMemory() const;
+	/*!
+     * @brief Get the spikes that occured during the last update.
+     * @details The spikes are added at the end of the vector, sorted by time step and then by neuron.
+     *
+     * @param spikes : a vector of spikes which receives the spikes of the last update
+     */
+	void getSpikes(std::vector<Spike>& spikes) const;
+	/*!
+     * @brief Get the list of the spikes that occured during the last update, without copying it.
+     * @details The list is sorted by time step and then by neuron. It's valid until the next update.
+     *
+     * @return A vector spikes_: the spikes of the last update
+     */
+	std::vector<Spike> const& getLastSpikes() const;
+#ifdef PROFILING
+	/*!
+     * @brief Get the duration of the update of the neurons during the last update (PROFILING only).
+     *
+     * @return A double integration_time_: the duration in seconds
+     */
+	double getIntegrationTime() const;
+	/*!
+     * @brief Get the duration of the delivery of the spikes during the last update (PROFILING only).
+     *
+     * @return A double delivery_time_: the duration in seconds
+     */
+	double getDeliveryTime() const;
+	/*!
+     * @brief Get the number of synaptic events delivered during the last update (PROFILING only).
+     * @details An event is one amplitude added to the time buffer of one target.
+     *
+     * @return A positive integer: the number of events
+     */
+	std::uint64_t getNumberDeliveries() const;
+#endif
+	/*!
+     * @brief Get a copy of one neuron of the network.
+     * @details The neuron returned is a Neuron with the same membrane potential, number of spikes,
+     * spike state, refractory state, clock and time buffer as the neuron of the network.
+     * The time of the last spike is only known while the neuron is in its refractory period,
+     * otherwise it is 0.0. The targets are not copied. The connections must have the delay D.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A Neuron: the copy of the neuron i
+     */
+	Neuron getNeuron(int i) const;
+
+	/*!
+     * @brief Set the external input received by all the neurons of the network.
+     *
+     * @param external_input : a double indicating the external input
+     */
+	void setExternalInput(double external_input);
+	/*!
+     * @brief Set the instructions used to update the neurons.
+     * @details By default the fastest instructions of the processor are used. The result doesn't depend on them.
+     *
+     * @param instructions : the instructions, supported by the processor
+     */
+	void setInstructions(Instructions instructions);
+	/*!
+     * @brief Set the amplitude of the spikes of the excitatory neurons and of the noises.
+     * @details The inhibitory neurons send -g times this amplitude. By default it's J_e.
+     *
+     * @param J : a double indicating the amplitude in millivolts
+     */
+	void setAmplitude(double J);
+	/*!
+     * @brief Set the membrane potential of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @param V_membrane : a double containing the value of the membrane potential
+     */
+	void setV_membrane(int i, double V_membrane);
+	/*!
+     * @brief Set the number of threads updating the network.
+     * @details The result of the simulation doesn't depend on the number of threads.
+     *
+     * @param nb_threads : an integer indicating the number of threads (at least 1)
+     */
+	void setNumberThreads(int nb_threads);
+
+	/*!
+     * @brief Set the connections of the network.
+     * @details The connections must be built and have the same number of neurons as the network.
+     * If they have delays longer than the time buffers, the time buffers get more boxes and keep
+     * the amplitudes already received.
+     *
+     * @param connectivity : a pointer on the connections between the neurons
+     */
+	void setConnectivity(std::shared_ptr<const Connectivity> connectivity);
+	/*!
+     * @brief Add the connections between all neurons in the network
+     * @details Every neuron receives conn_e connections from excitatory neurons and
+     * conn_i connections from inhibitory neurons, chosen randomly.
+     * The choices are the same as Neuron::addConnections. The connections are drawn by the threads of the network
+     * and don't depend on their number.
+     *
+     * @param seed : a positive integer used as seed for the choice of the connections
+     * @param conn_e : an integer indicating the number of excitatory connections received by each neuron
+     * @param conn_i : an integer indicating the number of inhibitory connections received by each neuron
+     */
+	void addConnections(unsigned int seed, int conn_e = c_e, int conn_i = c_i);
+	/*!
+     * @brief Save the whole state of the network in a checkpoint file.
+     * @details The neurons, the time buffers, the clock, the connections and the seed of the noises
+     * are written array by array (see CheckpointHeader). The spikes of the last update are not saved.
+     * The file is first written with the extension .tmp and renamed at the end, so a previous checkpoint
+     * is never lost if the program stops while writing.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void saveCheckpoint(std::string const& file_name) const;
+	/*!
+     * @brief Restore the state of the network saved in a checkpoint file.
+     * @details The file is mapped in memory and its arrays are copied in the network. The network must have
+     * the same number of excitatory and inhibitory neurons. The connections of the file replace the connections
+     * of the network, the number of threads doesn't change.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void loadCheckpoint(std::string const& file_name);
+	/*!
+     * @brief Update all the neurons of the network during one or several time steps.
+     * @details The neurons of each partition are updated in a single loop, with the same
+     * rules as Neuron::update, and the partitions are updated in parallel. The spikes of each partition
+     * are stored. Then each partition receives in parallel the amplitudes of all the spikes that target
+     * its neurons, which will be read after D time steps.
+     * No spike can be received before the smallest delay, so the partitions can be updated during
+     * up to getMinDelay() time steps before the spikes are sent: the threads are synchronized twice per update
+     * instead of twice per time step, and the result is exactly the same as updates of one time step.
+     * At the end the clock of the network advances of nb_steps time steps.
+     *
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the mean of the poisson generator of the noises,
+     * there is no noise if it's 0
+     * @param nb_steps : an integer indicating the number of time steps, between 1 and getMinDelay()
+     */
+	void update(double g, double pois, int nb_steps = 1);
+
+	/*!
+     * @brief The destructor of the class Network
+     */
+	~Network();
+
+private:
+	/*!
+     * @brief Update the neurons of one partition during several time steps
+     * @details The spikes are stored in the list of spikes of the partition,
+     * the targets are not updated here (see ::updatePartition).
+     *
+     * @param p : an integer indicating the index of the partition
+     * @param nb_steps : an integer indicating the number of time steps
+     * @param noise : a boolean, false when there is no noise
+     */
+	void updatePartition(int p, int nb_steps, bool noise);
+	/*!
+     * @brief Sum the membrane potentials of one partition in partition_potentials_
+     *
+     * @param p : an integer indicating the index of the partition
+     */
+	void sumPotentials(int p);
+	/*!
+     * @brief Give the time buffers max_delay+1 boxes
+     * @details The boxes of the next time steps are moved to their place in the new time buffers.
+     *
+     * @param max_delay : an integer indicating the largest delay in time steps
+     */
+	void setMaxDelay(int max_delay);
+	/*!
+     * @brief Merge the spikes of the partitions in the list of the spikes of the last update
+     * @details The list is sorted by time step and then by neuron, it's the only list read by the delivery
+     * and by getSpikes.
+     */
+	void mergeSpikes();
+	/*!
+     * @brief Send the amplitudes of the spikes of the last update to the neurons of a group of partitions
+     * @details Only the time buffers of the neurons of the group are filled, so the groups
+     * can be updated in parallel without writing in the same box. The spikes are read in the order of
+     * the list, so every box receives the amplitudes in the same order for any number of groups.
+     *
+     * @param group : an integer indicating the index of the group receiving the spikes
+     * @param nb_groups : an integer indicating the number of groups, the partitions are divided in contiguous groups
+     * @param ampl_e : a double indicating the amplitude of the spikes of the excitatory neurons
+     * @param ampl_i : a double indicating the amplitude of the spikes of the inhibitory neurons
+     */
+	void deliverGroup(int group, int nb_groups, double ampl_e, double ampl_i);
+
+	int nb_neurons_; //!< Total number of neurons
+
+	int nb_excitatory_; //!< Number of excitatory neurons, they are the first ones of the arrays
+
+	unsigned int clock_; //!< Clock of the network in time steps, shared by all the neurons
+
+	double external_input_; //!< External input received by all the neurons in millivolts
+
+	double amplitude_; //!< Amplitude J of the spikes of the excitatory neurons and of the noises
+
+	int min_delay_; //!< Smallest delay of the connections in time steps
+
+	int max_delay_; //!< Largest delay the time buffers can hold in time steps, they have max_delay_+1 boxes
+
+	LargeVector<double> V_membrane_; //!< Membrane potentials in millivolts
+
+	LargeVector<std::uint8_t> refractory_; //!< Refractory counters
+	//!< Number of time steps the neuron still has to stay in its refractory period, 0 if it can receive stimuli
+
+	LargeVector<char> spike_; //!< Spike states: 1 if the neuron has spiked during the last update
+
+	LargeVector<unsigned int> nb_spikes_; //!< Number of spikes of each neuron
+
+	LargeVector<float> t_buffer_; //!< Time buffers of all the neurons
+	//!< The box b of all the neurons is stored from b*nb_neurons_ to (b+1)*nb_neurons_-1, so the neurons read contiguous values
+	//!< The amplitudes are summed in single precision, which halves the memory read and written at each time step
+
+	std::shared_ptr<const Connectivity> connectivity_; //!< Connections between the neurons
+
+	std::unique_ptr<ThreadPool> pool_; //!< Threads updating the partitions
+
+	Instructions instructions_; //!< Instructions used to update the neurons
+
+	MembraneKernel kernel_; //!< Kernel updating the neurons of a partition during one time step
+
+	PoissonGenerator noise_; //!< Generator of the number of external spikes received by the neurons
+
+	std::vector<std::vector<Spike> > partition_spikes_; //!< Spikes of each partition during the last update, sorted by time step
+
+	std::vector<double> partition_potentials_; //!< Sum of the membrane potentials of each partition
+
+	std::vector<Spike> spikes_; //!< Spikes of the whole network during the last update, sorted by time step and by neuron
+	//!< Only the neurons of this list send amplitudes, the silent neurons cost nothing to the delivery
+
+	std::vector<std::vector<std::size_t> > positions_; //!< Position of each spike in its targets, one vector per group
+
+	std::vector<std::size_t> rows_; //!< First value of each box, twice, so the box of step+delay starts at rows_[step%(max_delay_+1) + delay]
+#ifdef PROFILING
+	double integration_time_; //!< Duration of the update of the neurons during the last update
+
+	double delivery_time_; //!< Duration of the delivery of the spikes during the last update
+
+	std::vector<std::uint64_t> deliveries_; //!< Number of synaptic events received by each group during the last update
+#endif
+};
+
+#endif
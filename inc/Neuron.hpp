@@ -5,6 +5,7 @@
 #include <fstream>
 #include <cmath>
 #include <array>
+#include <random>
 #include <vector>
 #include <cassert> 
 
@@ -358,8 +359,9 @@ public:
 	 * Those connections are choosen randomly. 
 	 * 
 	 * @param neurons : an array of pointer on neurons correponding to the neurons in the whole network (12500).
+	 * @param seed : a positive integer used as seed for the choice of the connections, random by default
 	 */
-	void addConnections (std::array<Neuron*, total_neurons>  const& neurons); 
+	void addConnections (std::array<Neuron*, total_neurons>  const& neurons, unsigned int seed = std::random_device()()); 
 	
 	/*!
 	 * @brief Generate random amplitudes from the rest of the brain
@@ -405,7 +407,7 @@ private:
 	
 	bool r_period_;	//!< Refractory state: true if the neuron is in its refractory period and can't receive stimuli 
 	
-	std::array <double, D+1> t_buffer_;//!<  Time buffer  
+	std::array <float, D+1> t_buffer_;//!<  Time buffer, in single precision like the time buffers of Network
 	//!< The time buffer has a size of D+1 to allow to correct add the amplitudes in a case
 	//!< that will be read with the correct delay by a target neuron.
 	//!< It stores the amplitude/the sum of the amplitudes of the signals received by a neuron 	
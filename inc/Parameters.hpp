@@ -0,0 +1,154 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <string>
+#include <vector>
+#include "Neuron.hpp"
+
+/*!
+     * @struct Parameters
+     * @details This structure contains the parameters of a simulation that can be chosen when the program
+     * is executed, without compiling it again. By default they have the values of the constants of Neuron.hpp,
+     * which describe the Brunel's network, and the program simulates the network with g = 5 and nu_ext/nu_thr = 2.
+     * The parameters are read from the command line (--name value or --name=value) and from configuration files
+     * (one "name = value" per line, the lines starting with # are comments). The file is given with --config and
+     * the parameters given after it on the command line replace the ones of the file.
+     * The parameters g and rate accept a list of values (3,4,5) or a range (start:stop:step, stop included):
+     * when several values are given, the simulation is done for each pair (g, rate) of the grid.
+     * The time constants and the threshold stay constants of the model. The delay of the connections is D
+     * by default, it can be one value or a range min:max (in milliseconds) from which the delay of each connection
+     * is drawn.
+     */
+struct Parameters
+{
+	/*!
+     * @brief The constructor of the structure Parameters.
+     * @details The parameters are initialized with the values of the Brunel's network.
+     */
+	Parameters();
+
+	/*!
+     * @brief Read the parameters given on the command line.
+     * @details An exception std::invalid_argument is thrown if a parameter is unknown or its value is not correct.
+     *
+     * @param argc : an integer indicating the number of arguments
+     * @param argv : the arguments, the first one is the name of the program
+     */
+	void readArguments(int argc, char** argv);
+	/*!
+     * @brief Read the parameters of a configuration file.
+     * @details An exception std::invalid_argument is thrown if the file can't be read,
+     * if a parameter is unknown or if its value is not correct.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void readFile(std::string const& file_name);
+	/*!
+     * @brief Set one parameter.
+     * @details An exception std::invalid_argument is thrown if the parameter is unknown or its value is not correct.
+     *
+     * @param name : a string indicating the name of the parameter
+     * @param value : a string containing the value of the parameter
+     */
+	void set(std::string const& name, std::string const& value);
+
+	/*!
+     * @brief Get the number of neurons.
+     *
+     * @return An integer: the number of excitatory and inhibitory neurons
+     */
+	int getNumberNeurons() const;
+	/*!
+     * @brief Get the number of time steps of the simulation.
+     *
+     * @return An integer: the duration divided by h
+     */
+	int getNumberSteps() const;
+	/*!
+     * @brief Know if several simulations have to be done.
+     *
+     * @return A boolean: true if g or rate have several values
+     */
+	bool isSweep() const;
+	/*!
+     * @brief Get the shortest delay of the connections in time steps.
+     *
+     * @return An integer: delay_min divided by h
+     */
+	int getMinDelay() const;
+	/*!
+     * @brief Get the longest delay of the connections in time steps.
+     *
+     * @return An integer: delay_max divided by h
+     */
+	int getMaxDelay() const;
+	/*!
+     * @brief Get the mean number of external spikes received by a neuron during one time step.
+     * @details The external neurons fire at nu_ext = rate*nu_thr, where nu_thr = V_thr/(J*C_e*tau) is the rate
+     * which brings the mean potential to the threshold, so the C_e external connections of a neuron receive
+     * rate*V_thr*h/(J*tau) spikes per time step (tau in milliseconds): the rate itself only when J = 0.1 mV.
+     *
+     * @param rate : a double indicating the rate nu_ext/nu_thr
+     * @return A double: the mean of the poisson generator of the noises
+     */
+	double getPoissonMean(double rate) const;
+
+	/*!
+     * @brief Get the description of all the parameters.
+     *
+     * @return A string: the text printed by --help
+     */
+	static std::string getUsage();
+
+	std::string mode; //!< Simulation executed: network, one, two, A, B, C or D (the graphs of the Brunel's network)
+
+	std::string engine; //!< Engine of the network simulation: step (all the neurons at each time step) or event (EventNetwork)
+
+	int nb_excitatory; //!< Number of excitatory neurons, at least 1
+
+	int nb_inhibitory; //!< Number of inhibitory neurons, at least 1
+
+	int conn_e; //!< Number of connections received from excitatory neurons, at least 1
+
+	int conn_i; //!< Number of connections received from inhibitory neurons, at least 1
+
+	double J; //!< Amplitude of the signal of an excitatory neuron in millivolts, strictly positive
+
+	std::vector<double> g; //!< Values of the rate J_i/J_e
+
+	std::vector<double> rate; //!< Values of the rate nu_ext/nu_thr, converted by getPoissonMean
+
+	double duration; //!< Duration of the simulation in milliseconds, at least one time step
+
+	double delay_min; //!< Shortest delay of the connections in milliseconds
+
+	double delay_max; //!< Longest delay of the connections in milliseconds, the delays are drawn between delay_min and delay_max
+
+	int window; //!< Number of time steps the neurons are updated before the spikes are sent, at most the shortest delay
+
+	int threads; //!< Number of threads updating the network, at least 1
+
+	std::string transport; //!< Distribution of the network between ranks: none, local (threads of this process) or mpi
+
+	int ranks; //!< Number of ranks of the local transport
+
+	unsigned int seed; //!< Seed of the random connections
+
+	unsigned int noise_seed; //!< Seed of the random noises
+
+	double external_input; //!< External input of the one and two neurons simulations, asked to the user if it's NaN
+
+	std::string output; //!< Name of the binary spike file, without the extension .bin
+
+	bool record; //!< True if the spikes are written in the binary spike file
+
+	double monitor; //!< Width of the bins of the population monitor in milliseconds, no monitor if it's 0
+
+	std::string checkpoint; //!< Name of the checkpoint file written at the end of the network simulation, none if empty
+
+	double checkpoint_interval; //!< Time between two checkpoints during the simulation in milliseconds, 0 for the end only
+
+	std::string restart; //!< Name of the checkpoint file the network simulation starts from, none if empty
+};
+
+#endif
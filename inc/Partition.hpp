@@ -0,0 +1,74 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Connectivity.hpp"
+#include "MembraneKernel.hpp"
+#include "PoissonGenerator.hpp"
+
+constexpr int partition_size (256); //!< number of neurons in one partition of the network
+
+/*!
+     * @struct Spike
+     * @details A spike of the network: the time step it occured and the index of the spiking neuron.
+     */
+struct Spike
+{
+	unsigned int step; //!< Time step of the spike
+	int neuron; //!< Index of the spiking neuron
+};
+
+/*!
+ * @brief Update the neurons of one partition during several time steps
+ * @details This is the update of Network and of DistributedNetwork: the box of each time step is read
+ * in the time buffers, the noises are drawn with the index of the neurons in the whole network
+ * and the neurons are updated by the membrane kernel.
+ *
+ * @param kernel : the membrane kernel
+ * @param block : the arrays of the neurons of the partition and the input, the box and the noise are set here
+ * @param t_buffer : the time buffers, moved to the first neuron of the partition
+ * @param rows : the first value of the box of each time step modulo nb_boxes
+ * @param nb_boxes : an integer indicating the number of boxes of the time buffers
+ * @param noise : the generator of the noises, nullptr without noise
+ * @param amplitude : a double indicating the amplitude of the noises
+ * @param first : an integer indicating the index of the first neuron of the partition in the whole network
+ * @param clock : an integer indicating the first time step
+ * @param nb_steps : an integer indicating the number of time steps
+ * @param spikes : a vector receiving the spikes of the partition, sorted by time step
+ */
+void updatePartition(MembraneKernel kernel, MembraneBlock block, float* t_buffer, const std::size_t* rows, int nb_boxes,
+					 const PoissonGenerator* noise, double amplitude, int first, unsigned int clock, int nb_steps,
+					 std::vector<Spike>& spikes);
+
+/*!
+ * @brief Send the amplitudes of spikes to several partitions
+ * @details This is the delivery of Network and of DistributedNetwork. The targets of a spiking neuron are sorted.
+ * The first target of each spike in the group is found by a binary search, then the partitions are filled one
+ * after the other: each spike continues from its position in the previous partition, so the writes stay in the boxes
+ * of one partition, which are in the cache, and every box receives the amplitudes in the order of the spikes.
+ * The amplitude of a spike is taken in a table by population, without branch, and the loop over its targets
+ * adds the same amplitude, or the amplitude times the weight of each connection if the connections have weights.
+ * When the connections have delays, each amplitude goes in the box of its own delay, found in the table rows.
+ * The targets can be stored on 16 or on 32 bits.
+ *
+ * @param connectivity : the connections, the targets are the indexes of the neurons in the time buffers
+ * @param spikes : the spikes, sorted by time step
+ * @param t_buffer : the time buffers
+ * @param rows : the first value of the box of each delay after the time step of a spike modulo nb_boxes
+ * @param nb_boxes : an integer indicating the number of boxes of the time buffers
+ * @param nb_neurons : an integer indicating the number of neurons in the time buffers
+ * @param nb_excitatory : an integer indicating the number of excitatory neurons, the first ones of the whole network
+ * @param first : an integer indicating the first partition
+ * @param last : an integer indicating the partition after the last one
+ * @param positions : a vector receiving the position of each spike in its targets
+ * @param ampl_e : a double indicating the amplitude of the spikes of the excitatory neurons
+ * @param ampl_i : a double indicating the amplitude of the spikes of the inhibitory neurons
+ * @return An integer: the number of amplitudes added
+ */
+std::uint64_t deliverSpikes(Connectivity const& connectivity, std::vector<Spike> const& spikes, float* t_buffer,
+							const std::size_t* rows, int nb_boxes, int nb_neurons, int nb_excitatory, int first, int last,
+							std::vector<std::size_t>& positions, double ampl_e, double ampl_i);
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef POISSONGENERATOR_H
+#define POISSONGENERATOR_H
+
+#include <vector>
+#include <cstdint>
+
+/*!
+     * @class PoissonGenerator
+     * @details This class draws the number of external spikes received by each neuron at each time step,
+     * following a poisson distribution of mean lambda, for all the neurons of a block at once.
+     * The random numbers come from a counter-based generator (Philox4x32-10): the number received by a neuron
+     * at a time step is a function of the seed, the index of the neuron and the time step only, so no state
+     * has to be kept, the neurons can be drawn in any order and by any thread, and the loops over the neurons
+     * are vectorized by the compiler. Each call of Philox gives 4 random integers of 32 bits, used by 4
+     * consecutive neurons.
+     * A random integer is transformed in a poisson number by inversion of the cumulative distribution:
+     * the distribution is computed once in a table of thresholds and a guide table gives, from the highest
+     * bits of the random integer, the first value to test, so one or two comparisons are enough.
+     * The probabilities below 2^-32 are ignored.
+     */
+
+class PoissonGenerator
+{
+public:
+	/*!
+     * @brief The constructor of the class PoissonGenerator.
+     *
+     * @param lambda : a double indicating the mean of the poisson distribution, 0 for no spikes
+     * @param seed : a positive integer used as seed of the random numbers
+     */
+	PoissonGenerator(double lambda = 0.0, std::uint32_t seed = 0);
+
+	/*!
+     * @brief Get the mean of the poisson distribution.
+     *
+     * @return A double lambda_: the mean
+     */
+	double getLambda() const;
+	/*!
+     * @brief Get the seed of the random numbers.
+     *
+     * @return A positive integer seed_: the seed
+     */
+	std::uint32_t getSeed() const;
+	/*!
+     * @brief Change the mean of the poisson distribution.
+     * @details The table of the distribution is computed again only if the mean changes.
+     *
+     * @param lambda : a double indicating the mean of the poisson distribution
+     */
+	void setLambda(double lambda);
+	/*!
+     * @brief Change the seed of the random numbers.
+     *
+     * @param seed : a positive integer used as seed of the random numbers
+     */
+	void setSeed(std::uint32_t seed);
+
+	/*!
+     * @brief Draw the number of spikes received by a block of neurons during one time step.
+     *
+     * @param step : a positive integer indicating the time step
+     * @param first : an integer indicating the index of the first neuron of the block
+     * @param size : an integer indicating the number of neurons of the block
+     * @param counts : the numbers of spikes of the neurons, size values
+     */
+	void generate(std::uint32_t step, int first, int size, unsigned int* counts) const;
+
+	/*!
+     * @brief Compute the 4 random integers of one counter with Philox4x32-10.
+     *
+     * @param counter : the 4 integers of the counter, replaced by the random integers
+     * @param key : the 2 integers of the key
+     */
+	static void philox(std::uint32_t counter[4], const std::uint32_t key[2]);
+
+	/*!
+     * @brief The destructor of the class PoissonGenerator
+     */
+	~PoissonGenerator();
+
+private:
+	/*!
+     * @brief Compute the tables of the distribution
+     */
+	void computeTables();
+
+	double lambda_; //!< Mean of the poisson distribution
+
+	std::uint32_t seed_; //!< Seed of the random numbers, first integer of the key of Philox
+
+	std::vector<std::uint64_t> thresholds_; //!< The value is k if the random integer is below thresholds_[k] and not below thresholds_[k-1]
+
+	std::vector<std::uint32_t> guide_; //!< First value to test for each value of the 8 highest bits of the random integer
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef POPULATIONMONITOR_H
+#define POPULATIONMONITOR_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Network.hpp"
+
+/*!
+     * @class PopulationMonitor
+     * @details This class measures the activity of the network during the simulation, after each window,
+     * so the spikes don't have to be written in a file to draw the population rate.
+     * The time is divided in bins of the same width. For each bin the monitor counts the spikes of the excitatory
+     * and of the inhibitory neurons and takes the mean membrane potential measured at the end of the windows;
+     * each bin is written in a CSV file as soon as it's complete, so the memory used doesn't depend on the duration.
+     * The rates of a bin are divided by the time steps it covers, so the last bin can be shorter than the others;
+     * as in SpikeAnalysis, a shorter last bin is left out of the synchrony index.
+     * The monitor also computes the rates of the whole simulation and the synchrony index of SpikeAnalysis
+     * (Golomb's chi squared), from sums kept for each neuron and for the population.
+     */
+
+class PopulationMonitor
+{
+public:
+	/*!
+     * @brief The constructor of the class PopulationMonitor.
+     *
+     * @param nb_neurons : an integer indicating the number of neurons of the network
+     * @param nb_excitatory : an integer indicating the number of excitatory neurons, the first ones
+     * @param bin_width : a double indicating the width of the bins in milliseconds
+     * @param file_name : a string indicating the name of the CSV file, no file if it's empty
+     * @param start : an integer indicating the time step where the monitor starts, at the beginning of a bin
+     * @param dt : a double indicating the time step of the simulation in milliseconds
+     */
+	PopulationMonitor(int nb_neurons, int nb_excitatory, double bin_width, std::string const& file_name = "",
+					  unsigned int start = t_start, double dt = h);
+
+	/*!
+     * @brief Add the activity of one window.
+     * @details The bins ending before the clock are complete and written in the file.
+     *
+     * @param spikes : the spikes of the window, sorted by time step
+     * @param clock : an integer indicating the time step after the window
+     * @param mean_potential : a double indicating the mean membrane potential at the end of the window
+     */
+	void add(std::vector<Spike> const& spikes, unsigned int clock, double mean_potential);
+	/*!
+     * @brief End the monitor.
+     * @details The last bin is written, even if the duration isn't a multiple of the width of the bins.
+     *
+     * @param nb_steps : an integer indicating the time step of the end of the simulation
+     */
+	void finish(unsigned int nb_steps);
+
+	/*!
+     * @brief Get the number of time steps in a bin.
+     *
+     * @return An integer bin_steps_: the number of time steps
+     */
+	unsigned int getBinSteps() const;
+	/*!
+     * @brief Get the number of bins complete.
+     *
+     * @return An integer nb_bins_: the number of bins written
+     */
+	int getNumberBins() const;
+	/*!
+     * @brief Get the number of spikes of a population.
+     *
+     * @param excitatory : a boolean, true for the excitatory neurons and false for the inhibitory ones
+     * @return An integer: the number of spikes of the bins complete
+     */
+	std::uint64_t getNumberSpikes(bool excitatory) const;
+	/*!
+     * @brief Get the mean rate of the neurons.
+     *
+     * @return A double: the rate of the bins complete in Hz, the last bin counts until the end of the simulation
+     */
+	double getRate() const;
+	/*!
+     * @brief Get the mean rate of the neurons of a population.
+     *
+     * @param excitatory : a boolean, true for the excitatory neurons and false for the inhibitory ones
+     * @return A double: the rate of the bins complete in Hz, 0 if the population is empty
+     */
+	double getRate(bool excitatory) const;
+	/*!
+     * @brief Get the mean membrane potential of the bins.
+     *
+     * @return A double: the mean of the potentials of the bins complete in millivolts
+     */
+	double getMeanPotential() const;
+	/*!
+     * @brief Get the synchrony index of the network.
+     * @details The index is the same as SpikeAnalysis::getSynchrony for the same bins.
+     *
+     * @return A double: the synchrony index between 0 and 1, NaN if no neuron spiked
+     */
+	double getSynchrony() const;
+
+	/*!
+     * @brief The destructor of the class PopulationMonitor
+     */
+	~PopulationMonitor();
+
+private:
+	/*!
+     * @brief Get the duration of the bins complete
+     *
+     * @return A double: the duration in milliseconds
+     */
+	double getDuration() const;
+	/*!
+     * @brief Write the current bin and start the next one
+     * @details The number of spikes of each neuron in the bin is added to its sum of squares,
+     * only the neurons that spiked in the bin are read.
+     */
+	void closeBin();
+
+	int nb_neurons_; //!< Number of neurons of the network
+
+	int nb_excitatory_; //!< Number of excitatory neurons
+
+	double dt_; //!< Time step in milliseconds
+
+	unsigned int bin_steps_; //!< Number of time steps in a bin
+
+	unsigned int start_; //!< First time step of the monitor
+
+	unsigned int end_; //!< Time step after the last window added
+
+	unsigned int bin_start_; //!< First time step of the current bin
+
+	int nb_bins_; //!< Number of bins complete
+
+	std::uint64_t bin_spikes_[2]; //!< Number of spikes of the inhibitory (0) and excitatory (1) neurons in the current bin
+
+	double bin_potential_; //!< Sum of the mean potentials measured in the current bin
+
+	int bin_samples_; //!< Number of mean potentials measured in the current bin
+
+	double last_potential_; //!< Last mean potential measured, used for the bins without measure
+
+	std::uint64_t nb_spikes_[2]; //!< Number of spikes of the inhibitory (0) and excitatory (1) neurons in the bins complete
+
+	double potential_sum_; //!< Sum of the mean potentials of the bins complete
+
+	double count_sum_; //!< Sum of the mean number of spikes of the neurons in the bins
+
+	double count_sum2_; //!< Sum of the squares of the mean number of spikes of the neurons in the bins
+
+	std::vector<unsigned int> neuron_spikes_; //!< Number of spikes of each neuron in the bins of the full width
+
+	std::vector<unsigned int> neuron_count_; //!< Number of spikes of each neuron in the current bin
+
+	std::vector<double> neuron_sum2_; //!< Sum of the squares of the number of spikes of each neuron in the bins
+
+	std::vector<int> spiking_; //!< Neurons that spiked in the current bin
+
+	std::ofstream file_; //!< CSV file of the bins
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+constexpr double high_rate (100.0); //!< Mean firing rate in Hz above which the report warns that the delivery cost explodes
+
+/*!
+     * @enum Phase
+     * @details The phases of a network simulation whose durations are measured.
+     */
+enum class Phase
+{
+	initialization, //!< Allocation of the network and of the spike file
+	wiring, //!< Creation of the connections
+	integration, //!< Update of the membrane potentials
+	delivery, //!< Sending of the amplitudes of the spikes to the targets
+	recording //!< Writing of the spikes in the file
+};
+
+constexpr int nb_phases (5); //!< Number of phases
+
+/*!
+     * @class Profiler
+     * @details This class collects the durations of the phases of a network simulation and the activity of each
+     * window of time steps: the number of spikes, also per time step, and the number of synaptic events delivered
+     * (one amplitude added to one target). The windows are written in a trace file (CSV, one line per window) and a summary is printed
+     * regularly: firing rate, events delivered per second and part of the time spent in each phase, with a warning
+     * when the network enters a regime of high firing rate, where the delivery becomes the main cost.
+     * The measures are only taken by the program compiled with the option PROFILING, otherwise the class is not used
+     * and the simulation has no overhead.
+     */
+
+class Profiler
+{
+public:
+	/*!
+     * @brief The constructor of the class Profiler.
+     *
+     * @param nb_neurons : an integer indicating the number of neurons of the network
+     * @param trace_file : a string indicating the name of the trace file, no trace if it's empty
+     * @param report_interval : a positive integer indicating the number of time steps between two summaries, none if it's 0
+     * @param output : the stream where the summaries are printed
+     */
+	Profiler(int nb_neurons, std::string const& trace_file = "", unsigned int report_interval = 0,
+			 std::ostream& output = std::cout);
+
+	/*!
+     * @brief Get the current time of a steady clock.
+     *
+     * @return A double: the time in seconds
+     */
+	static double now();
+	/*!
+     * @brief Get the name of a phase.
+     *
+     * @param phase : the phase
+     * @return A string: the name of the phase
+     */
+	static std::string getName(Phase phase);
+
+	/*!
+     * @brief Get the total duration of a phase.
+     *
+     * @param phase : the phase
+     * @return A double: the duration in seconds
+     */
+	double getTime(Phase phase) const;
+	/*!
+     * @brief Get the total number of spikes of the windows added.
+     *
+     * @return A positive integer: the number of spikes
+     */
+	std::uint64_t getNumberSpikes() const;
+	/*!
+     * @brief Get the total number of synaptic events delivered during the windows added.
+     *
+     * @return A positive integer: the number of events
+     */
+	std::uint64_t getNumberDeliveries() const;
+	/*!
+     * @brief Get the total number of time steps of the windows added.
+     *
+     * @return A positive integer: the number of time steps
+     */
+	std::uint64_t getNumberSteps() const;
+
+	/*!
+     * @brief Add a duration to a phase.
+     *
+     * @param phase : the phase
+     * @param seconds : a double indicating the duration in seconds
+     */
+	void addTime(Phase phase, double seconds);
+	/*!
+     * @brief Add the activity of one window of time steps, written in the trace.
+     * @details The durations of the phases since the last window are written with the activity, and the number
+     * of spikes of each time step of the window in the last column, separated by semicolons. The synaptic events
+     * are delivered once per window, so they are only counted per window. A summary is printed when the clock
+     * passes a multiple of the report interval.
+     *
+     * @param clock : a positive integer indicating the time step at the end of the window
+     * @param nb_steps : an integer indicating the number of time steps of the window
+     * @param nb_spikes : a positive integer indicating the number of spikes of the window
+     * @param nb_deliveries : a positive integer indicating the number of synaptic events delivered
+     * @param step_spikes : a vector indicating the number of spikes of each time step, nb_steps values or none
+     */
+	void addWindow(unsigned int clock, int nb_steps, std::uint64_t nb_spikes, std::uint64_t nb_deliveries,
+				   std::vector<unsigned int> const& step_spikes = std::vector<unsigned int>());
+	/*!
+     * @brief Print the summary of the whole simulation.
+     */
+	void printSummary();
+
+	/*!
+     * @brief The destructor of the class Profiler
+     */
+	~Profiler();
+
+private:
+	/*!
+     * @brief Print one line of summary for the time steps since the last one
+     *
+     * @param clock : a positive integer indicating the current time step
+     */
+	void report(unsigned int clock);
+
+	int nb_neurons_; //!< Number of neurons of the network
+
+	unsigned int report_interval_; //!< Number of time steps between two summaries
+
+	std::ostream& output_; //!< Stream of the summaries
+
+	std::ofstream trace_; //!< Trace file, one line per window
+
+	std::array<double, nb_phases> times_; //!< Total duration of each phase
+
+	std::array<double, nb_phases> window_times_; //!< Duration of each phase since the last window
+
+	std::uint64_t nb_spikes_; //!< Total number of spikes
+
+	std::uint64_t nb_deliveries_; //!< Total number of synaptic events delivered
+
+	std::uint64_t nb_steps_; //!< Total number of time steps
+
+	std::uint64_t report_spikes_; //!< Number of spikes since the last summary
+
+	std::uint64_t report_deliveries_; //!< Number of synaptic events since the last summary
+
+	std::uint64_t report_steps_; //!< Number of time steps since the last summary
+
+	double report_start_; //!< Time of the last summary in seconds
+};
+
+#endif
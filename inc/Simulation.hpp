@@ -4,6 +4,12 @@
 #include <iostream>
 #include <array>
 #include "Neuron.hpp"
+#include "Network.hpp"
+#include "EventNetwork.hpp"
+#include "DistributedNetwork.hpp"
+#include "SpikeRecorder.hpp"
+#include "Parameters.hpp"
+#include "Profiler.hpp"
 
 /*!
      * @class Simulation
@@ -20,6 +26,8 @@
      * After the whole network simulation, 4 graphs with two different ratios can
      * be generated. 
      * Some additional functions allow a better modularisation.
+     * The parameters (size of the network, g, nu_ext/nu_thr, duration, seeds...) are given at the construction,
+     * so the same program can simulate any network and a whole grid of (g, nu_ext/nu_thr) without being compiled again.
      */
      
 class Simulation
@@ -28,8 +36,22 @@ public:
 
 	/*!
      * @brief Constructor of the Simulation class
+     *
+     * @param parameters : the parameters of the simulations, by default the ones of the Brunel's network
      */
-	Simulation();
+	Simulation(Parameters const& parameters = Parameters());
+	/*!
+     * @brief Execute the simulation chosen by the parameter mode
+     * @details If g or nu_ext/nu_thr have several values, the network is simulated for all the pairs (g, nu_ext/nu_thr).
+     */
+	void run();
+	/*!
+     * @brief Simulate the network for all the pairs (g, nu_ext/nu_thr) of the parameters
+     * @details The spikes of each simulation are written in the file output_g<g>_rate<nu_ext/nu_thr>.bin.
+     * The connections are created once and shared by all the simulations, which are executed at the same time.
+     * The mean rate, the synchrony index and the regime of each point are written in output_sweep.csv.
+     */
+	void sweep();
 	/*!
      * @brief Simulate the brunel's network with one neuron
      * @details The neuron in the network has to spikes when its membrane potential cross the threshold. 
@@ -55,20 +77,48 @@ public:
 	void twoNeruonsSimulation();
 	/*!
      * @brief Simulate the brunel's network with the whole network of 12500 neurons.
-     * @details An array of neurons will be created to store all the inhibitory and excitatory neurons. After initializing it,
+     * @details A Network will be created to store all the inhibitory and excitatory neurons in contiguous arrays. After initializing it,
      * the conncetions are created between all the neurons. Finally all the neurons are updated. When a neuron spikes it sends 
      * the corresponding amplitude to all the post-synaptic neurons which will see their membrane potential increase, and will
      * spike too, and so on for the whole simulation.
      * The noises from the rest of the brain are presents and contribute increasing the memrane potential at each time step.
-     * There is a file that stores all the time a neuron spikes and its index. This will allow creating the 4 graphs of the
-     * brunel's network.
+     * There is a binary file (Spike_time.bin) that stores all the time a neuron spikes and its index. This will allow creating
+     * the 4 graphs of the brunel's network.
      * 
-     * @param g :  a double indicating the rate between inhibitory connections and excitatory connections 
-     * @param pois : a double indicating the rate between inhibitory connections and excitatory connections 
+     * The size of the network, the connections, the duration and the seeds are given by the parameters of the simulation.
+     * The network can start from the state saved in a checkpoint file (restart) and its state can be saved
+     * regularly and at the end (checkpoint).
      * 
+     * @param g :  a double indicating the rate between inhibitory connections and excitatory connections 
+     * @param pois : a double indicating the rate nu_ext/nu_thr, converted by Parameters::getPoissonMean
+     * @param file_name : a string indicating the name of the binary spike file, by default the output of the parameters
      * 
      */
-	void networkSimulation(double g, double pois);
+	void networkSimulation(double g, double pois, std::string const& file_name = "");
+	/*!
+     * @brief Simulate the network with the event-driven engine
+     * @details The same network as networkSimulation is simulated by an EventNetwork: only the neurons receiving
+     * spikes or noises are updated, the potentials between two events are computed exactly. It is faster when
+     * the network is quiet (few spikes and a small nu_ext/nu_thr), the statistics are the same but not the spikes.
+     * The checkpoints are not available with this engine.
+     *
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the rate nu_ext/nu_thr, converted by Parameters::getPoissonMean
+     * @param file_name : a string indicating the name of the binary spike file, by default the output of the parameters
+     */
+	void eventSimulation(double g, double pois, std::string const& file_name = "");
+	/*!
+     * @brief Simulate the network divided between several ranks
+     * @details With the local transport the ranks are threads of this process, with the mpi transport they are
+     * the processes started by mpirun. Each rank draws the connections towards its neurons, updates them and
+     * exchanges its spikes with the other ranks after each window. The rank 0 writes all the spikes, the file
+     * is the same as the one of networkSimulation. The checkpoints are not available with several ranks.
+     *
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the rate nu_ext/nu_thr, converted by Parameters::getPoissonMean
+     * @param file_name : a string indicating the name of the binary spike file, by default the output of the parameters
+     */
+	void distributedSimulation(double g, double pois, std::string const& file_name = "");
 	
 	/*!
      * @brief Plot the graph A of the brunel's model
@@ -104,21 +154,15 @@ public:
 	void plotGraph_D();
 	/*!
      * @brief Let the user set the external input for the simulation
+     * @details The user is asked only if the external input is not given by the parameters.
      *  
      * @return a double input : the value of the external input
      */
      double externalInput();
      /*!
-     * @brief Initialize the table of fixed size of pointers on neurons (12500)
-     * @details There are 10000 excitatory neruons and 2500 inhibitory neurons
-     *  
-     * @param ns : array of pointer on neurons that has to be inizialize. The parameter is 
-     * passed by reference because it has to be modified.
-     */
-     void initializeNeurons(std::array <Neuron*, total_neurons>& ns);
-     /*!
      * @brief Open the python script
-     * @details The name of the python script in "system" remains constant
+     * @details The binary file of the spikes is first converted in the text file Spike_time.txt read by the script.
+     * The name of the python script in "system" remains constant. Nothing is done if the spikes are not recorded.
      * 
      */
      void pythonScript();
@@ -127,7 +171,19 @@ public:
      */
 	~Simulation();
 
-	
+private:
+	/*!
+     * @brief Simulate the neurons of one rank of a distributed simulation
+     *
+     * @param transport : the communication between the ranks
+     * @param nb_threads : an integer indicating the number of threads of the rank
+     * @param g : a double indicating the rate J_i/J_e
+     * @param pois : a double indicating the rate nu_ext/nu_thr, converted by Parameters::getPoissonMean
+     * @param file_name : a string indicating the name of the binary spike file written by the rank 0
+     */
+	void simulateRank(std::shared_ptr<Transport> transport, int nb_threads, double g, double pois, std::string const& file_name);
+
+	Parameters parameters_; //!< Parameters of the simulations
 };
 
 #endif
@@ -0,0 +1,197 @@
+#ifndef SPIKEANALYSIS_H
+#define SPIKEANALYSIS_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "SpikeReader.hpp"
+
+/*!
+     * @class SpikeAnalysis
+     * @details This class computes the statistics of the spikes of a simulation in a single pass.
+     * The spikes are given one after the other, sorted by time step, and only a few values are kept
+     * for each neuron, so the spikes never have to be stored.
+     * The time is divided in bins of the same width. The statistics computed are:
+     * the population rate in each bin (the histogram drawn by Graphs.py), the firing rate of each neuron,
+     * the coefficient of variation of the interspike intervals of each neuron (CV) and the Fano factor
+     * of the number of spikes of each neuron in the bins. The synchrony index of the network compares the fluctuations
+     * of the population rate to the fluctuations of the neurons.
+     * The results can be written in two CSV files.
+     */
+
+class SpikeAnalysis
+{
+public:
+	/*!
+     * @brief The constructor of the class SpikeAnalysis.
+     *
+     * @param nb_neurons : an integer indicating the number of neurons of the network
+     * @param bin_width : a double indicating the width of the bins in milliseconds
+     * @param dt : a double indicating the time step of the simulation in milliseconds
+     */
+	SpikeAnalysis(int nb_neurons, double bin_width, double dt = h);
+
+	/*!
+     * @brief Add one spike to the statistics.
+     * @details The spikes must be added in the order of the time steps.
+     *
+     * @param spike : the spike
+     */
+	void add(Spike const& spike);
+	/*!
+     * @brief Add all the spikes of a binary spike file to the statistics.
+     *
+     * @param reader : the reader of the file
+     */
+	void add(SpikeReader const& reader);
+	/*!
+     * @brief End the analysis.
+     * @details The number of bins is fixed by the duration and the counts of the last bin are used.
+     * When the duration isn't a multiple of the width, the last bin is shorter: its rate is divided by the time steps
+     * it covers, and it's left out of the Fano factors and of the synchrony index, which compare bins of the same width.
+     * The results can be read only after.
+     *
+     * @param nb_steps : an integer indicating the duration of the simulation in time steps
+     */
+	void finish(unsigned int nb_steps);
+
+	/*!
+     * @brief Get the number of time steps in a bin.
+     *
+     * @return An integer bin_steps_: the number of time steps
+     */
+	unsigned int getBinSteps() const;
+	/*!
+     * @brief Get the number of bins.
+     *
+     * @return An integer: the number of bins
+     */
+	int getNumberBins() const;
+	/*!
+     * @brief Get the number of spikes in one bin.
+     *
+     * @param b : an integer indicating the index of the bin
+     * @return An integer: the number of spikes of all the neurons in the bin
+     */
+	std::uint64_t getBinCount(int b) const;
+	/*!
+     * @brief Get the population rate in one bin.
+     *
+     * @param b : an integer indicating the index of the bin
+     * @return A double: the mean rate of the neurons in the bin in Hz, the last bin can be shorter than the others
+     */
+	double getPopulationRate(int b) const;
+	/*!
+     * @brief Get the number of spikes of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return An integer: the number of spikes
+     */
+	unsigned int getNumberSpikes(int i) const;
+	/*!
+     * @brief Get the firing rate of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A double: the rate in Hz, 0 if the duration is 0
+     */
+	double getRate(int i) const;
+	/*!
+     * @brief Get the coefficient of variation of the interspike intervals of one neuron.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A double: the standard deviation of the intervals over their mean, NaN if there are less than 2 intervals
+     */
+	double getCV(int i) const;
+	/*!
+     * @brief Get the Fano factor of the number of spikes of one neuron in the complete bins.
+     *
+     * @param i : an integer indicating the index of the neuron
+     * @return A double: the variance of the number of spikes over its mean, NaN if the neuron never spikes in them
+     */
+	double getFano(int i) const;
+	/*!
+     * @brief Get the mean firing rate of the neurons.
+     *
+     * @return A double: the mean rate in Hz
+     */
+	double getMeanRate() const;
+	/*!
+     * @brief Get the mean coefficient of variation of the neurons having at least 2 intervals.
+     *
+     * @return A double: the mean CV, NaN if no neuron has 2 intervals
+     */
+	double getMeanCV() const;
+	/*!
+     * @brief Get the mean Fano factor of the neurons that spiked.
+     *
+     * @return A double: the mean Fano factor, NaN if no neuron spiked
+     */
+	double getMeanFano() const;
+	/*!
+     * @brief Get the synchrony index of the network.
+     * @details The index is the variance of the mean number of spikes of the neurons in the bins divided by the mean
+     * of the variances of the neurons (Golomb's chi squared). It's about 1/N when the neurons spike independently
+     * and 1 when they all spike in the same bins.
+     *
+     * @return A double: the synchrony index between 0 and 1 in the complete bins, NaN if no neuron spiked in them
+     */
+	double getSynchrony() const;
+
+	/*!
+     * @brief Write the population rate in a CSV file.
+     * @details The file has one line per bin: the beginning of the bin in milliseconds,
+     * the number of spikes and the population rate in Hz.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void writePopulation(std::string const& file_name) const;
+	/*!
+     * @brief Write the statistics of the neurons in a CSV file.
+     * @details The file has one line per neuron: the index, the number of spikes, the rate in Hz,
+     * the CV and the Fano factor.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void writeNeurons(std::string const& file_name) const;
+
+	/*!
+     * @brief The destructor of the class SpikeAnalysis
+     */
+	~SpikeAnalysis();
+
+private:
+	/*!
+     * @brief Count the spikes of the current bin of one neuron for the Fano factor
+     *
+     * @param i : an integer indicating the index of the neuron
+     */
+	void closeBin(int i);
+
+	int nb_neurons_; //!< Number of neurons of the network
+
+	double dt_; //!< Time step in milliseconds
+
+	unsigned int bin_steps_; //!< Number of time steps in a bin
+
+	unsigned int nb_steps_; //!< Duration in time steps, known at the end
+
+	unsigned int last_step_; //!< Time step of the last spike added
+
+	std::vector<std::uint64_t> bins_; //!< Number of spikes in each bin
+
+	std::vector<unsigned int> nb_spikes_; //!< Number of spikes of each neuron
+
+	std::vector<int> last_spike_; //!< Time step of the last spike of each neuron, -1 if none
+
+	std::vector<double> isi_sum_; //!< Sum of the interspike intervals of each neuron in time steps
+
+	std::vector<double> isi_sum2_; //!< Sum of the squares of the interspike intervals of each neuron
+
+	std::vector<unsigned int> bin_; //!< Current bin of each neuron
+
+	std::vector<unsigned int> bin_count_; //!< Number of spikes of each neuron in its current bin, in the shorter last bin after finish
+
+	std::vector<double> count_sum2_; //!< Sum of the squares of the number of spikes of each neuron in the bins
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef SPIKEREADER_H
+#define SPIKEREADER_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "SpikeRecorder.hpp"
+
+/*!
+     * @class SpikeReader
+     * @details This class reads a binary spike file written by a SpikeRecorder.
+     * The file is mapped in memory instead of being read: the spikes are read directly in the pages
+     * of the file loaded by the system, so even files of several gigabytes can be read in one pass
+     * without being copied.
+     */
+
+class SpikeReader
+{
+public:
+	/*!
+     * @brief The constructor of the class SpikeReader.
+     * @details The file is opened and mapped in memory, and the header is checked.
+     *
+     * @param file_name : a string indicating the name of the binary file
+     */
+	SpikeReader(std::string const& file_name);
+
+	/*!
+     * @brief Get the header of the file.
+     *
+     * @return A SpikeFileHeader: the header, with the number of spikes found in the file
+     */
+	SpikeFileHeader getHeader() const;
+	/*!
+     * @brief Get the number of spikes in the file.
+     *
+     * @return An integer nb_spikes_: the number of spikes
+     */
+	std::uint64_t getNumberSpikes() const;
+	/*!
+     * @brief Get one spike of the file.
+     *
+     * @param k : an integer indicating the index of the spike
+     * @return A Spike: the time step and the neuron of the k-th spike
+     */
+	Spike getSpike(std::uint64_t k) const;
+	/*!
+     * @brief Get the records of the spikes
+     * @details The spike k is given by the step at 2*k and the neuron at 2*k+1.
+     *
+     * @return A pointer on the first record, after the header
+     */
+	const std::uint32_t* getRecords() const;
+
+	/*!
+     * @brief The destructor of the class SpikeReader
+     * @details The file is unmapped and closed.
+     */
+	~SpikeReader();
+
+private:
+	SpikeReader(SpikeReader const&) = delete;
+	SpikeReader& operator=(SpikeReader const&) = delete;
+
+	int file_; //!< File descriptor of the binary file
+
+	std::size_t size_; //!< Size of the file in bytes
+
+	const char* data_; //!< Beginning of the file in memory
+
+	SpikeFileHeader header_; //!< Header of the file
+
+	std::uint64_t nb_spikes_; //!< Number of complete spikes in the file
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SPIKERECORDER_H
+#define SPIKERECORDER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "Network.hpp"
+
+/*!
+     * @struct SpikeFileHeader
+     * @details Header at the beginning of a binary spike file.
+     * The file starts with this header of 48 bytes, followed by one record of 8 bytes per spike:
+     * the time step of the spike and the index of the spiking neuron, both as unsigned integers on 32 bits.
+     * The spikes are sorted by time step and then by neuron. All the values are written in the byte order
+     * of the computer (little endian on x86). The number of spikes is written when the file is closed,
+     * if it's 0 the number of spikes is given by the size of the file.
+     */
+struct SpikeFileHeader
+{
+	char magic[8]; //!< "BRUNELSP", identifies a binary spike file
+	std::uint32_t version; //!< Version of the format, 1
+	std::uint32_t nb_neurons; //!< Number of neurons of the network
+	double h; //!< Time step of the simulation in milliseconds
+	double g; //!< Rate J_i/J_e of the simulation
+	double pois; //!< Rate nu_ext/nu_thr of the simulation
+	std::uint64_t nb_spikes; //!< Number of spikes recorded
+};
+
+/*!
+     * @class SpikeRecorder
+     * @details This class writes the spikes of a simulation in a binary spike file.
+     * Writing the spikes as text is slow and produces big files, so the spikes are stored as
+     * pairs of integers in blocks. When a block is full, it is given to a writer thread which writes it
+     * in the file while the simulation continues. If the writer thread is late, the simulation waits
+     * when max_blocks blocks are waiting, so the memory used stays bounded.
+     * The binary file can be converted to the text format used by Graphs.py with convertToText.
+     */
+
+class SpikeRecorder
+{
+public:
+	/*!
+     * @brief The constructor of the class SpikeRecorder.
+     * @details The file is opened, the header is written and the writer thread starts.
+     *
+     * @param file_name : a string indicating the name of the binary file
+     * @param nb_neurons : an integer indicating the number of neurons of the network
+     * @param g : a double indicating the rate J_i/J_e of the simulation
+     * @param pois : a double indicating the rate nu_ext/nu_thr of the simulation
+     * @param block_size : an integer indicating the number of spikes in a block
+     */
+	SpikeRecorder(std::string const& file_name, int nb_neurons, double g, double pois,
+				  std::size_t block_size = 1 << 16);
+
+	/*!
+     * @brief Get the number of spikes recorded.
+     *
+     * @return An integer nb_spikes_: the number of spikes
+     */
+	std::uint64_t getNumberSpikes() const;
+
+	/*!
+     * @brief Record one spike.
+     *
+     * @param spike : the spike that has to be recorded
+     */
+	void record(Spike const& spike);
+	/*!
+     * @brief Record all the spikes of a vector.
+     *
+     * @param spikes : a vector of spikes sorted by time step, as given by Network::getSpikes
+     */
+	void record(std::vector<Spike> const& spikes);
+	/*!
+     * @brief Write the last spikes and close the file.
+     * @details The writer thread ends and the number of spikes is written in the header.
+     * Nothing can be recorded after.
+     */
+	void close();
+
+	/*!
+     * @brief Convert a binary spike file in a text file.
+     * @details The text file has one line per spike with the time step and the index of the neuron
+     * separated by a tabulation, as the file Spike_time.txt read by Graphs.py.
+     *
+     * @param binary_name : a string indicating the name of the binary file
+     * @param text_name : a string indicating the name of the text file
+     * @return An integer: the number of spikes converted
+     */
+	static std::uint64_t convertToText(std::string const& binary_name, std::string const& text_name);
+
+	/*!
+     * @brief The destructor of the class SpikeRecorder
+     * @details The file is closed if it's not done yet.
+     */
+	~SpikeRecorder();
+
+private:
+	/*!
+     * @brief Give the current block to the writer thread
+     */
+	void flushBlock();
+	/*!
+     * @brief Loop of the writer thread: write the full blocks in the file until the recorder is closed
+     */
+	void write();
+
+	static constexpr std::size_t max_blocks = 8; //!< Maximal number of blocks waiting for the writer thread
+
+	std::ofstream file_; //!< Binary spike file
+
+	std::size_t block_size_; //!< Number of spikes in a block
+
+	std::vector<std::uint32_t> block_; //!< Current block, two integers per spike
+
+	std::deque<std::vector<std::uint32_t> > full_blocks_; //!< Blocks waiting for the writer thread
+
+	std::mutex mutex_; //!< Protects the blocks waiting and the state of the recorder
+
+	std::condition_variable ready_; //!< Wakes the writer thread when a block is full
+
+	std::condition_variable space_; //!< Wakes the simulation when a block has been written
+
+	bool closing_; //!< True when the writer thread has to end
+
+	bool closed_; //!< True when the file is closed
+
+	std::uint64_t nb_spikes_; //!< Number of spikes recorded
+
+	std::thread writer_; //!< Thread writing the blocks
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "Network.hpp"
+#include "Parameters.hpp"
+
+/*!
+     * @struct SweepPoint
+     * @details This structure contains the summary of the simulation of one point (g, nu_ext/nu_thr) of a sweep.
+     */
+struct SweepPoint
+{
+	double g; //!< Rate J_i/J_e
+
+	double rate; //!< Rate nu_ext/nu_thr
+
+	std::uint64_t nb_spikes; //!< Number of spikes of all the neurons
+
+	double mean_rate; //!< Mean firing rate of the neurons in Hz
+
+	double synchrony; //!< Synchrony index of the network, between 0 and 1
+
+	double cv; //!< Mean coefficient of variation of the interspike intervals
+
+	std::string regime; //!< State of the network: SR, SI, AR, AI or quiescent
+};
+
+/*!
+     * @class Sweep
+     * @details This class simulates the network for all the pairs (g, nu_ext/nu_thr) of the parameters to draw the
+     * phase diagram of the Brunel's network. The connections are created once and shared by all the simulations,
+     * which only read them, and each simulation has its own neurons, so several points are simulated at the same time
+     * by different threads. The spikes of each point are analysed while the network is updated: the summary of a point
+     * contains the mean rate, the synchrony index, the mean CV of the interspike intervals and the regime of the network.
+     * The spikes can also be written in one binary file per point.
+     */
+
+class Sweep
+{
+public:
+	/*!
+     * @brief The constructor of the class Sweep.
+     *
+     * @param parameters : the parameters of the simulations, g and rate give the points of the sweep
+     * @param record : a boolean, true if the spikes of each point are written in output_g<g>_rate<nu_ext/nu_thr>.bin
+     * (with the parameter monitor, the rates of each point are written in output_g<g>_rate<nu_ext/nu_thr>_population.csv)
+     */
+	Sweep(Parameters const& parameters, bool record = true);
+
+	/*!
+     * @brief Simulate all the points of the sweep.
+     * @details The connections are created with the seed of the parameters before the first point.
+     */
+	void run();
+
+	/*!
+     * @brief Get the connections shared by all the simulations.
+     *
+     * @return A shared pointer connectivity_: the connections, nullptr before run
+     */
+	std::shared_ptr<const Connectivity> getConnectivity() const;
+	/*!
+     * @brief Get the number of points of the sweep.
+     *
+     * @return An integer: the number of pairs (g, nu_ext/nu_thr)
+     */
+	int getNumberPoints() const;
+	/*!
+     * @brief Get the summary of one point.
+     *
+     * @param k : an integer indicating the index of the point, the values of nu_ext/nu_thr change first
+     * @return The summary of the simulation
+     */
+	SweepPoint const& getPoint(int k) const;
+	/*!
+     * @brief Write the summaries of all the points in a CSV file.
+     * @details The file has one line per point: g, nu_ext/nu_thr, the number of spikes, the mean rate in Hz,
+     * the synchrony index, the mean CV and the regime.
+     *
+     * @param file_name : a string indicating the name of the file
+     */
+	void write(std::string const& file_name) const;
+
+	/*!
+     * @brief Find the regime of the network from its statistics.
+     * @details The network is synchronous (S) if the synchrony index is more than synchrony_threshold and asynchronous (A)
+     * otherwise, the neurons are irregular (I) if the mean CV is more than cv_threshold and regular (R) otherwise.
+     * The network is quiescent if the mean rate is less than 0.1 Hz.
+     *
+     * @param mean_rate : a double indicating the mean rate in Hz
+     * @param synchrony : a double indicating the synchrony index
+     * @param cv : a double indicating the mean CV, NaN if the neurons don't spike enough
+     * @return A string: SR, SI, AR, AI or quiescent
+     */
+	static std::string classify(double mean_rate, double synchrony, double cv);
+
+	static constexpr double bin_width = 1.0; //!< Width of the bins of the synchrony index in milliseconds
+
+	static constexpr double synchrony_threshold = 0.05; //!< Synchrony index above which the network is synchronous
+
+	static constexpr double cv_threshold = 0.5; //!< Mean CV above which the neurons are irregular
+
+	/*!
+     * @brief The destructor of the class Sweep
+     */
+	~Sweep();
+
+private:
+	/*!
+     * @brief Simulate one point of the sweep
+     *
+     * @param k : an integer indicating the index of the point
+     * @param nb_threads : an integer indicating the number of threads updating the network of the point
+     */
+	void runPoint(int k, int nb_threads);
+
+	Parameters parameters_; //!< Parameters of the simulations
+
+	bool record_; //!< True if the spikes are written in files
+
+	std::shared_ptr<const Connectivity> connectivity_; //!< Connections shared by all the simulations
+
+	std::vector<SweepPoint> points_; //!< Summary of each point
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/*!
+     * @class ThreadPool
+     * @details This class keeps a fixed number of threads alive during the whole simulation,
+     * so that no thread is created at every time step.
+     * The pool executes a number of tasks identified by their index: each thread takes the next
+     * task not yet done until all the tasks are done. The thread calling run also executes tasks,
+     * so a pool of one thread has no additional thread and executes everything in the calling thread.
+     * The tasks of one call must be independent because their order is not known.
+     */
+
+class ThreadPool
+{
+public:
+	/*!
+     * @brief The constructor of the class ThreadPool.
+     * @details nb_threads-1 threads are created and wait for tasks.
+     *
+     * @param nb_threads : an integer indicating the number of threads executing the tasks (at least 1)
+     */
+	ThreadPool(int nb_threads = 1);
+
+	/*!
+     * @brief Get the number of threads executing the tasks, the calling thread included.
+     *
+     * @return An integer: the number of threads
+     */
+	int getNumberThreads() const;
+
+	/*!
+     * @brief Execute the tasks and wait until all of them are done.
+     *
+     * @param nb_tasks : an integer indicating the number of tasks
+     * @param task : the function executed for each task, it receives the index of the task
+     */
+	void run(int nb_tasks, std::function<void(int)> const& task);
+
+	/*!
+     * @brief The destructor of the class ThreadPool
+     * @details The threads are stopped and joined.
+     */
+	~ThreadPool();
+
+private:
+	/*!
+     * @brief Execute the tasks not yet taken by the other threads
+     */
+	void executeTasks();
+	/*!
+     * @brief Loop of the threads of the pool: wait for new tasks and execute them
+     */
+	void work();
+
+	std::vector<std::thread> workers_; //!< Threads of the pool, the calling thread is not included
+
+	std::mutex mutex_; //!< Protects the members shared between the threads
+
+	std::condition_variable start_; //!< Wakes the threads when new tasks are given
+
+	std::condition_variable done_; //!< Wakes the calling thread when the threads have finished
+
+	std::function<void(int)> const* task_; //!< Function of the current tasks
+
+	int nb_tasks_; //!< Number of the current tasks
+
+	std::atomic<int> next_task_; //!< Index of the next task not yet taken
+
+	int running_; //!< Number of threads of the pool still executing the current tasks
+
+	unsigned long generation_; //!< Incremented every time new tasks are given
+
+	bool stop_; //!< True when the threads have to end
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "Network.hpp"
+
+#ifdef USE_MPI
+//only the C interface of MPI is used
+#define OMPI_SKIP_MPICXX
+#define MPICH_SKIP_MPICXX
+#include <mpi.h>
+#endif
+
+/*!
+     * @class Transport
+     * @details This class is the interface of the communication between the processes (ranks) of a distributed
+     * simulation. The only communication needed by the network is the exchange of the spikes after each window
+     * of time steps: every rank gives its own spikes and receives the spikes of all the ranks, in the order of
+     * the ranks (all-to-all of the pairs time step and index of the spiking neuron).
+     */
+
+class Transport
+{
+public:
+	/*!
+     * @brief Get the index of this rank.
+     *
+     * @return An integer: the rank, between 0 and the number of ranks - 1
+     */
+	virtual int getRank() const = 0;
+	/*!
+     * @brief Get the number of ranks of the simulation.
+     *
+     * @return An integer: the number of ranks
+     */
+	virtual int getNumberRanks() const = 0;
+	/*!
+     * @brief Send the spikes of this rank to all the ranks and receive the spikes of all the ranks.
+     * @details All the ranks must call it the same number of times. The spikes received are the spikes
+     * sent by the rank 0, then the ones of the rank 1, and so on, this rank included.
+     *
+     * @param sent : the spikes of this rank
+     * @param received : the vector replaced by the spikes of all the ranks
+     */
+	virtual void exchange(std::vector<Spike> const& sent, std::vector<Spike>& received) = 0;
+
+	/*!
+     * @brief The destructor of the class Transport
+     */
+	virtual ~Transport();
+};
+
+/*!
+     * @class LocalTransport
+     * @details The ranks are threads of the same process which share the memory, so a distributed simulation
+     * can be tested on one computer without MPI. Each rank publishes its spikes, waits until all the ranks
+     * have published, copies the spikes of all the ranks and waits again until all the copies are done.
+     */
+
+class LocalTransport : public Transport
+{
+public:
+	/*!
+     * @brief Create the transports of all the ranks of a local group.
+     *
+     * @param nb_ranks : an integer indicating the number of ranks (at least 1)
+     * @return A vector of the transports, the transport k is the rank k
+     */
+	static std::vector<std::shared_ptr<Transport>> createGroup(int nb_ranks);
+
+	int getRank() const override;
+	int getNumberRanks() const override;
+	void exchange(std::vector<Spike> const& sent, std::vector<Spike>& received) override;
+
+private:
+	/*!
+     * @struct Group
+     * @details The memory shared by the ranks of a group.
+     */
+	struct Group
+	{
+		std::mutex mutex; //!< Protects the members of the group
+
+		std::condition_variable arrived; //!< Wakes the ranks when the last rank arrives at the barrier
+
+		std::vector<const std::vector<Spike>*> spikes; //!< Spikes published by each rank
+
+		int nb_waiting; //!< Number of ranks waiting at the barrier
+
+		unsigned long generation; //!< Incremented every time all the ranks have arrived at the barrier
+	};
+
+	/*!
+     * @brief The constructor of the class LocalTransport, used by createGroup
+     *
+     * @param group : the memory shared by the ranks
+     * @param rank : an integer indicating the index of the rank
+     */
+	LocalTransport(std::shared_ptr<Group> group, int rank);
+	/*!
+     * @brief Wait until all the ranks of the group have arrived
+     */
+	void barrier();
+
+	std::shared_ptr<Group> group_; //!< Memory shared by the ranks
+
+	int rank_; //!< Index of the rank
+};
+
+#ifdef USE_MPI
+
+/*!
+     * @class MpiTransport
+     * @details The ranks are the processes of an MPI communicator, started for example with mpirun.
+     * The number of spikes of each rank is exchanged first, then the spikes themselves as bytes.
+     * MPI is initialized by the first transport created if it isn't already, and finalized by its destructor.
+     */
+
+class MpiTransport : public Transport
+{
+public:
+	/*!
+     * @brief The constructor of the class MpiTransport.
+     *
+     * @param communicator : the communicator of the ranks, all the processes by default
+     */
+	MpiTransport(MPI_Comm communicator = MPI_COMM_WORLD);
+
+	int getRank() const override;
+	int getNumberRanks() const override;
+	void exchange(std::vector<Spike> const& sent, std::vector<Spike>& received) override;
+
+	/*!
+     * @brief The destructor of the class MpiTransport
+     */
+	~MpiTransport();
+
+private:
+	MPI_Comm communicator_; //!< Communicator of the ranks
+
+	bool initialized_; //!< True if MPI has been initialized by this transport
+
+	std::vector<int> counts_; //!< Number of bytes of the spikes of each rank
+
+	std::vector<int> displacements_; //!< Position of the spikes of each rank in the received bytes
+};
+
+#endif
+
+#endif
@@ -0,0 +1,346 @@
+#include "Connectivity.hpp"
+#include "ThreadPool.hpp"
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+
+
+Connectivity::Connectivity(int nb_neurons)
+: Connectivity(nb_neurons, 0, nb_neurons)
+{}
+
+Connectivity::Connectivity(int nb_neurons, int first_target, int nb_targets)
+: nb_neurons_(nb_neurons),
+  first_target_(first_target),
+  nb_targets_(nb_targets),
+  offsets_(nb_neurons+1, 0)
+{
+	assert(nb_neurons >= 0);
+	assert(first_target >= 0 and nb_targets >= 0 and first_target + nb_targets <= nb_neurons);
+}
+
+int Connectivity::getNumberNeurons() const
+{
+	return nb_neurons_;
+}
+
+int Connectivity::getFirstTarget() const
+{
+	return first_target_;
+}
+
+int Connectivity::getNumberTargetNeurons() const
+{
+	return nb_targets_;
+}
+
+std::size_t Connectivity::getNumberConnections() const
+{
+	return offsets_[nb_neurons_];
+}
+
+int Connectivity::getNumberTargets(int source) const
+{
+	return offsets_[source+1] - offsets_[source];
+}
+
+int Connectivity::getTarget(int source, int k) const
+{
+	assert(k >= 0 and k < getNumberTargets(source));
+	if (isNarrow()){
+		return narrow_targets_[offsets_[source] + k];
+	}
+	return wide_targets_[offsets_[source] + k];
+}
+
+std::size_t Connectivity::getMemory() const
+{
+	return offsets_.size()*sizeof(std::size_t)
+		 + narrow_targets_.size()*sizeof(std::uint16_t)
+		 + wide_targets_.size()*sizeof(std::uint32_t)
+		 + weights_.size()*sizeof(float)
+		 + delays_.size()*sizeof(std::uint8_t);
+}
+
+bool Connectivity::isNarrow() const
+{
+	return nb_targets_ <= std::numeric_limits<std::uint16_t>::max() + 1;
+}
+
+const std::size_t* Connectivity::getOffsets() const
+{
+	return offsets_.data();
+}
+
+const std::uint16_t* Connectivity::getNarrowTargets() const
+{
+	return isNarrow() ? narrow_targets_.data() : nullptr;
+}
+
+const std::uint32_t* Connectivity::getWideTargets() const
+{
+	return isNarrow() ? nullptr : wide_targets_.data();
+}
+
+bool Connectivity::hasWeights() const
+{
+	return not weights_.empty();
+}
+
+float Connectivity::getWeight(int source, int k) const
+{
+	assert(k >= 0 and k < getNumberTargets(source));
+	return hasWeights() ? weights_[offsets_[source] + k] : 1.0f;
+}
+
+const float* Connectivity::getWeights() const
+{
+	return hasWeights() ? weights_.data() : nullptr;
+}
+
+bool Connectivity::hasDelays() const
+{
+	return not delays_.empty();
+}
+
+int Connectivity::getDelay(int source, int k) const
+{
+	assert(k >= 0 and k < getNumberTargets(source));
+	return hasDelays() ? delays_[offsets_[source] + k] : D;
+}
+
+const std::uint8_t* Connectivity::getDelays() const
+{
+	return hasDelays() ? delays_.data() : nullptr;
+}
+
+int Connectivity::getMinDelay() const
+{
+	return hasDelays() ? *std::min_element(delays_.begin(), delays_.end()) : D;
+}
+
+int Connectivity::getMaxDelay() const
+{
+	return hasDelays() ? *std::max_element(delays_.begin(), delays_.end()) : D;
+}
+
+void Connectivity::addConnection(int source, int target)
+{
+	//the weights and the delays follow the order of the connections built
+	assert(not hasWeights() and not hasDelays());
+	assert(source >= 0 and source < nb_neurons_);
+	assert(target >= first_target_ and target < first_target_ + nb_targets_);
+	pending_sources_.push_back(source);
+	pending_targets_.push_back(target - first_target_);
+}
+
+void Connectivity::build()
+{
+	if (pending_sources_.empty()){
+		return;
+	}
+	//the connections already built are kept in front of the new ones
+	Connectivity old(*this);
+
+	//count the targets of each neuron
+	std::vector<std::size_t> counts(nb_neurons_, 0);
+	for (int i(0); i<nb_neurons_; ++i){
+		counts[i] = old.getNumberTargets(i);
+	}
+	for (auto const& s : pending_sources_){
+		++counts[s];
+	}
+	offsets_[0] = 0;
+	for (int i(0); i<nb_neurons_; ++i){
+		offsets_[i+1] = offsets_[i] + counts[i];
+	}
+	allocateTargets();
+
+	//the counts become the next free position of each neuron
+	for (int i(0); i<nb_neurons_; ++i){
+		counts[i] = offsets_[i];
+		for (int k(0); k<old.getNumberTargets(i); ++k){
+			setTarget(counts[i]++, old.getTarget(i, k));
+		}
+	}
+	for (size_t e(0); e<pending_sources_.size(); ++e){
+		setTarget(counts[pending_sources_[e]]++, pending_targets_[e]);
+	}
+	sortTargets();
+	pending_sources_.clear();
+	pending_sources_.shrink_to_fit();
+	pending_targets_.clear();
+	pending_targets_.shrink_to_fit();
+}
+
+void Connectivity::addRandomConnections(int nb_excitatory, int conn_e, int conn_i, unsigned int seed, int nb_threads)
+{
+	assert(pending_sources_.empty() and getNumberConnections() == 0);
+	assert(nb_excitatory > 0 and nb_excitatory < nb_neurons_);
+	//only the blocks containing the range of targets are drawn
+	const int first_block(first_target_/connection_block);
+	const int nb_blocks((first_target_ + nb_targets_ + connection_block - 1)/connection_block - first_block);
+	//each task draws a contiguous group of blocks and counts the targets of its blocks
+	const int nb_tasks(std::max(1, std::min(nb_threads, nb_blocks)));
+	std::vector<std::vector<std::uint32_t>> counts(nb_tasks);
+	ThreadPool pool (nb_tasks);
+
+	//first pass: count the targets of each neuron in each group of blocks
+	pool.run(nb_tasks, [&](int t){
+		counts[t].assign(nb_neurons_, 0);
+		std::uint32_t* count (counts[t].data());
+		for (int b(first_block + t*nb_blocks/nb_tasks); b<first_block + (t+1)*nb_blocks/nb_tasks; ++b){
+			drawSources(b, nb_excitatory, conn_e, conn_i, seed, [=](int source, int){ ++count[source]; });
+		}
+	});
+
+	//the counts of each neuron become the position of the targets of each group in the targets of the neuron
+	pool.run(nb_tasks, [&](int t){
+		for (int i(t*nb_neurons_/nb_tasks); i<(t+1)*nb_neurons_/nb_tasks; ++i){
+			std::uint32_t total(0);
+			for (auto& count : counts){
+				const std::uint32_t c(count[i]);
+				count[i] = total;
+				total += c;
+			}
+			offsets_[i+1] = total;
+		}
+	});
+	offsets_[0] = 0;
+	for (int i(0); i<nb_neurons_; ++i){
+		offsets_[i+1] += offsets_[i];
+	}
+	allocateTargets();
+
+	//second pass: the same numbers are drawn again and the targets are stored,
+	//they are sorted because the groups and the post-synaptic neurons of a group are taken in order
+	pool.run(nb_tasks, [&](int t){
+		std::uint32_t* count (counts[t].data());
+		for (int b(first_block + t*nb_blocks/nb_tasks); b<first_block + (t+1)*nb_blocks/nb_tasks; ++b){
+			drawSources(b, nb_excitatory, conn_e, conn_i, seed, [=](int source, int target){
+				setTarget(offsets_[source] + count[source]++, target);
+			});
+		}
+	});
+}
+
+void Connectivity::addWeights(float weight)
+{
+	assert(pending_sources_.empty());
+	weights_.assign(getNumberConnections(), weight);
+}
+
+void Connectivity::setWeight(int source, int k, float weight)
+{
+	assert(hasWeights() and k >= 0 and k < getNumberTargets(source));
+	weights_[offsets_[source] + k] = weight;
+}
+
+void Connectivity::addDelays(int delay)
+{
+	assert(pending_sources_.empty());
+	assert(delay >= 1 and delay <= max_delay);
+	delays_.assign(getNumberConnections(), delay);
+}
+
+void Connectivity::addRandomDelays(int shortest, int longest, unsigned int seed)
+{
+	assert(pending_sources_.empty());
+	assert(shortest >= 1 and shortest <= longest and longest <= max_delay);
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<> dis (shortest, longest);
+	delays_.resize(getNumberConnections());
+	for (auto& delay : delays_){
+		delay = dis(gen);
+	}
+}
+
+void Connectivity::setDelay(int source, int k, int delay)
+{
+	assert(hasDelays() and k >= 0 and k < getNumberTargets(source));
+	assert(delay >= 1 and delay <= max_delay);
+	delays_[offsets_[source] + k] = delay;
+}
+
+void Connectivity::assign(const std::size_t* offsets, const void* targets, const float* weights, const std::uint8_t* delays)
+{
+	assert(offsets[0] == 0);
+	pending_sources_.clear();
+	pending_targets_.clear();
+	offsets_.assign(offsets, offsets + nb_neurons_ + 1);
+	allocateTargets();
+	if (isNarrow()){
+		std::memcpy(narrow_targets_.data(), targets, narrow_targets_.size()*sizeof(std::uint16_t));
+	} else {
+		std::memcpy(wide_targets_.data(), targets, wide_targets_.size()*sizeof(std::uint32_t));
+	}
+	if (weights != nullptr){
+		weights_.assign(weights, weights + offsets_[nb_neurons_]);
+	} else {
+		weights_.clear();
+	}
+	if (delays != nullptr){
+		delays_.assign(delays, delays + offsets_[nb_neurons_]);
+	} else {
+		delays_.clear();
+	}
+}
+
+template <typename Function>
+void Connectivity::drawSources(int block, int nb_excitatory, int conn_e, int conn_i, unsigned int seed, Function const& connect) const
+{
+	std::seed_seq seq {seed, (unsigned int)(block)};
+	std::mt19937 gen(seq);
+	//distributions of the indexes of the excitatory and of the inhibitory neurons
+	std::uniform_int_distribution<> dis_e (0, nb_excitatory-1);
+	std::uniform_int_distribution<> dis_i (nb_excitatory, nb_neurons_-1);
+	for (int j(block*connection_block); j<std::min(nb_neurons_, (block+1)*connection_block); ++j){
+		//the numbers of the neurons out of the range are drawn too, so the generator gives the same connections
+		const bool in_range(j >= first_target_ and j < first_target_ + nb_targets_);
+		for (int k(0); k<conn_e; ++k){
+			const int source(dis_e(gen));
+			if (in_range){
+				connect(source, j - first_target_);
+			}
+		}
+		for (int k(0); k<conn_i; ++k){
+			const int source(dis_i(gen));
+			if (in_range){
+				connect(source, j - first_target_);
+			}
+		}
+	}
+}
+
+void Connectivity::setTarget(std::size_t position, int target)
+{
+	if (isNarrow()){
+		narrow_targets_[position] = target;
+	} else {
+		wide_targets_[position] = target;
+	}
+}
+
+void Connectivity::sortTargets()
+{
+	for (int i(0); i<nb_neurons_; ++i){
+		if (isNarrow()){
+			std::sort(narrow_targets_.begin() + offsets_[i], narrow_targets_.begin() + offsets_[i+1]);
+		} else {
+			std::sort(wide_targets_.begin() + offsets_[i], wide_targets_.begin() + offsets_[i+1]);
+		}
+	}
+}
+
+void Connectivity::allocateTargets()
+{
+	if (isNarrow()){
+		narrow_targets_.assign(offsets_[nb_neurons_], 0);
+	} else {
+		wide_targets_.assign(offsets_[nb_neurons_], 0);
+	}
+}
+
+Connectivity::~Connectivity()
+{}
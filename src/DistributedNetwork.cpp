@@ -0,0 +1,167 @@
+#include "DistributedNetwork.hpp"
+#include <algorithm>
+#include <cassert>
+
+
+DistributedNetwork::DistributedNetwork(int nb_excitatory, int nb_inhibitory, unsigned int seed,
+									   std::shared_ptr<Transport> transport)
+: nb_neurons_(nb_excitatory + nb_inhibitory),
+  nb_excitatory_(nb_excitatory),
+  clock_(t_start),
+  external_input_(0.0),
+  amplitude_(J_e),
+  transport_(transport),
+  pool_(new ThreadPool(1)),
+  kernel_(getMembraneKernel(getBestInstructions())),
+  noise_(0.0, seed)
+{
+	assert(nb_excitatory >= 0 and nb_inhibitory >= 0);
+	assert(transport != nullptr);
+	//each rank receives a contiguous range of partitions
+	const int nb_partitions((nb_neurons_ + partition_size - 1)/partition_size);
+	const int rank(transport_->getRank()), nb_ranks(transport_->getNumberRanks());
+	first_ = std::min(nb_neurons_, rank*nb_partitions/nb_ranks*partition_size);
+	nb_local_ = std::min(nb_neurons_, (rank+1)*nb_partitions/nb_ranks*partition_size) - first_;
+
+	V_membrane_.assign(nb_local_, 0.0);
+	refractory_.assign(nb_local_, 0);
+	spike_.assign(nb_local_, 0);
+	nb_spikes_.assign(nb_local_, 0);
+	t_buffer_.assign(nb_local_*(D+1), 0.0);
+	//the box of a time step and of each delay after it, as in Network
+	rows_.resize(2*D+1);
+	for (size_t j(0); j<rows_.size(); ++j){
+		rows_[j] = (j%(D+1))*nb_local_;
+	}
+	connectivity_ = std::make_shared<Connectivity>(nb_neurons_, first_, nb_local_);
+	partition_spikes_.resize((nb_local_ + partition_size - 1)/partition_size);
+}
+
+int DistributedNetwork::getNumberNeurons() const
+{
+	return nb_neurons_;
+}
+
+int DistributedNetwork::getFirstNeuron() const
+{
+	return first_;
+}
+
+int DistributedNetwork::getNumberLocalNeurons() const
+{
+	return nb_local_;
+}
+
+double DistributedNetwork::getV_membrane(int i) const
+{
+	assert(i >= first_ and i < first_ + nb_local_);
+	return V_membrane_[i - first_];
+}
+
+unsigned int DistributedNetwork::getNumberSpikes(int i) const
+{
+	assert(i >= first_ and i < first_ + nb_local_);
+	return nb_spikes_[i - first_];
+}
+
+bool DistributedNetwork::getRefractoryState(int i) const
+{
+	assert(i >= first_ and i < first_ + nb_local_);
+	return refractory_[i - first_] > 0;
+}
+
+unsigned int DistributedNetwork::getClock() const
+{
+	return clock_;
+}
+
+std::shared_ptr<const Connectivity> DistributedNetwork::getConnectivity() const
+{
+	return connectivity_;
+}
+
+void DistributedNetwork::getSpikes(std::vector<Spike>& spikes) const
+{
+	spikes.insert(spikes.end(), spikes_.begin(), spikes_.end());
+}
+
+std::vector<Spike> const& DistributedNetwork::getLastSpikes() const
+{
+	return spikes_;
+}
+
+void DistributedNetwork::setExternalInput(double external_input)
+{
+	external_input_ = external_input;
+}
+
+void DistributedNetwork::setAmplitude(double J)
+{
+	amplitude_ = J;
+}
+
+void DistributedNetwork::setNumberThreads(int nb_threads)
+{
+	pool_.reset(new ThreadPool(nb_threads));
+}
+
+void DistributedNetwork::addConnections(unsigned int seed, int conn_e, int conn_i)
+{
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(nb_neurons_, first_, nb_local_));
+	connectivity->addRandomConnections(nb_excitatory_, conn_e, conn_i, seed, pool_->getNumberThreads());
+	connectivity_ = connectivity;
+}
+
+void DistributedNetwork::update(double g, double pois, int nb_steps)
+{
+	assert(nb_steps >= 1 and nb_steps <= D);
+	//the time buffers have D+1 boxes, the delays of the connections can't be longer
+	assert(connectivity_->getMaxDelay() <= D and nb_steps <= connectivity_->getMinDelay());
+	noise_.setLambda(std::max(0.0, pois));
+	pool_->run(partition_spikes_.size(), [=](int p){ updatePartition(p, nb_steps, pois > 0.0); });
+
+	//the spikes of the partitions follow each other, and the ones of the ranks too,
+	//so the spikes received are in the order of the partitions of the whole network
+	sent_.clear();
+	for (auto const& spikes : partition_spikes_){
+		sent_.insert(sent_.end(), spikes.begin(), spikes.end());
+	}
+	transport_->exchange(sent_, spikes_);
+	//the neurons of a time step stay in the order of their index
+	std::stable_sort(spikes_.begin(), spikes_.end(), [](Spike const& a, Spike const& b){ return a.step < b.step; });
+
+	const double ampl_e(amplitude_);
+	const double ampl_i(-g*amplitude_);
+	const int nb_groups(std::min<int>(pool_->getNumberThreads(), partition_spikes_.size()));
+	positions_.resize(nb_groups);
+	pool_->run(nb_groups, [=](int group){ deliverGroup(group, nb_groups, ampl_e, ampl_i); });
+	clock_ += nb_steps*N;
+}
+
+void DistributedNetwork::updatePartition(int p, int nb_steps, bool noise)
+{
+	const int begin(p*partition_size);
+	const int end(std::min(begin + partition_size, nb_local_));
+
+	std::vector<Spike>& spikes(partition_spikes_[p]);
+	spikes.clear();
+
+	//the noises and the spikes have the index of the neurons in the whole network
+	MembraneBlock block {&V_membrane_[begin], &refractory_[begin], &spike_[begin], &nb_spikes_[begin],
+						 nullptr, nullptr, end - begin, const2*external_input_};
+	::updatePartition(kernel_, block, &t_buffer_[begin], rows_.data(), D+1, noise ? &noise_ : nullptr,
+					  amplitude_, first_ + begin, clock_, nb_steps, spikes);
+}
+
+void DistributedNetwork::deliverGroup(int group, int nb_groups, double ampl_e, double ampl_i)
+{
+	const int nb_partitions(partition_spikes_.size());
+	const int first(group*nb_partitions/nb_groups);
+	const int last((group + 1)*nb_partitions/nb_groups);
+	//the targets are relative to the first neuron of the rank
+	deliverSpikes(*connectivity_, spikes_, t_buffer_.data(), rows_.data(), D+1, nb_local_, nb_excitatory_,
+				  first, last, positions_[group], ampl_e, ampl_i);
+}
+
+DistributedNetwork::~DistributedNetwork()
+{}
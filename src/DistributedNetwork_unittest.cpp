@@ -0,0 +1,114 @@
+#include <iostream>
+#include "DistributedNetwork.hpp"
+#include "gtest/gtest.h"
+#include <thread>
+#include <cassert>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the connections drawn towards a range of neurons are the connections of the whole network
+ * towards these neurons
+*/
+
+TEST (DistributedNetworkTest, LocalConnections){
+	Connectivity network(1000), range(1000, 300, 400);
+	network.addRandomConnections(800, 80, 20, 13);
+	range.addRandomConnections(800, 80, 20, 13, 2);
+	EXPECT_EQ (400*100u, range.getNumberConnections());
+	EXPECT_TRUE (range.isNarrow());
+	for (int i(0); i<1000; ++i){
+		std::vector<int> targets;
+		for (int k(0); k<network.getNumberTargets(i); ++k){
+			if (network.getTarget(i, k) >= 300 and network.getTarget(i, k) < 700){
+				targets.push_back(network.getTarget(i, k) - 300);
+			}
+		}
+		ASSERT_EQ (int(targets.size()), range.getNumberTargets(i));
+		for (size_t k(0); k<targets.size(); ++k){
+			EXPECT_EQ (targets[k], range.getTarget(i, k));
+		}
+	}
+}
+
+/*
+ * TEST2: Test if every rank of a local group receives the spikes of all the ranks in the order of the ranks
+*/
+
+TEST (DistributedNetworkTest, Exchange){
+	std::vector<std::shared_ptr<Transport>> transports(LocalTransport::createGroup(3));
+	std::vector<std::vector<Spike>> received(3);
+	std::vector<std::thread> ranks;
+	for (int r(0); r<3; ++r){
+		ranks.push_back(std::thread([&, r]{
+			EXPECT_EQ (r, transports[r]->getRank());
+			EXPECT_EQ (3, transports[r]->getNumberRanks());
+			for (int t(0); t<10; ++t){
+				std::vector<Spike> sent(r, Spike {(unsigned int)(t), r}); //the rank r sends r spikes
+				transports[r]->exchange(sent, received[r]);
+			}
+		}));
+	}
+	for (auto& rank : ranks){
+		rank.join();
+	}
+	for (auto const& spikes : received){
+		ASSERT_EQ (3u, spikes.size());
+		EXPECT_EQ (1, spikes[0].neuron);
+		EXPECT_EQ (2, spikes[1].neuron);
+		EXPECT_EQ (2, spikes[2].neuron);
+		EXPECT_EQ (9u, spikes[2].step);
+	}
+}
+
+/*
+ * TEST3: Test if a network distributed between 3 ranks gives exactly the same result as one Network
+*/
+
+TEST (DistributedNetworkTest, SameAsNetwork){
+	Network network(800, 200, 17);
+	network.addConnections(18, 80, 20);
+	std::vector<Spike> network_spikes;
+	for (int t(0); t<40; ++t){
+		network.update(5, 2, D);
+		network.getSpikes(network_spikes);
+	}
+
+	std::vector<std::shared_ptr<Transport>> transports(LocalTransport::createGroup(3));
+	std::vector<std::vector<Spike>> spikes(3);
+	std::vector<std::thread> ranks;
+	for (int r(0); r<3; ++r){
+		ranks.push_back(std::thread([&, r]{
+			DistributedNetwork part(800, 200, 17, transports[r]);
+			part.addConnections(18, 80, 20);
+			for (int t(0); t<40; ++t){
+				part.update(5, 2, D);
+				part.getSpikes(spikes[r]);
+			}
+			EXPECT_EQ (network.getClock(), part.getClock());
+			for (int i(part.getFirstNeuron()); i<part.getFirstNeuron() + part.getNumberLocalNeurons(); ++i){
+				EXPECT_EQ (network.getV_membrane(i), part.getV_membrane(i));
+				EXPECT_EQ (network.getNumberSpikes(i), part.getNumberSpikes(i));
+				EXPECT_EQ (network.getRefractoryState(i), part.getRefractoryState(i));
+			}
+		}));
+	}
+	for (auto& rank : ranks){
+		rank.join();
+	}
+	EXPECT_GT (network_spikes.size(), 0u);
+	for (auto const& rank_spikes : spikes){
+		//every rank knows all the spikes of the network
+		ASSERT_EQ (network_spikes.size(), rank_spikes.size());
+		for (size_t k(0); k<rank_spikes.size(); ++k){
+			EXPECT_EQ (network_spikes[k].step, rank_spikes[k].step);
+			EXPECT_EQ (network_spikes[k].neuron, rank_spikes[k].neuron);
+		}
+	}
+}
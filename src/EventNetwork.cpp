@@ -0,0 +1,237 @@
+#include "EventNetwork.hpp"
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+
+
+constexpr unsigned int no_spike (std::numeric_limits<unsigned int>::max()); //!< Predicted time step of a neuron never crossing the threshold without input
+
+
+EventNetwork::EventNetwork(int nb_excitatory, int nb_inhibitory, unsigned int seed)
+: nb_neurons_(nb_excitatory + nb_inhibitory),
+  nb_excitatory_(nb_excitatory),
+  clock_(t_start),
+  external_input_(0.0),
+  amplitude_(J_e),
+  V_inf_(0.0),
+  V_membrane_(nb_neurons_, 0.0),
+  last_(nb_neurons_, t_start),
+  nb_spikes_(nb_neurons_, 0),
+  predicted_(nb_neurons_, no_spike),
+  t_buffer_(nb_neurons_*(D+1), 0.0),
+  received_(D+1),
+  listed_(nb_neurons_, 0),
+  connectivity_(std::make_shared<Connectivity>(nb_neurons_)),
+  gen_(seed),
+  nb_events_(0)
+{
+	assert(nb_excitatory >= 0 and nb_inhibitory >= 0);
+}
+
+int EventNetwork::getNumberNeurons() const
+{
+	return nb_neurons_;
+}
+
+double EventNetwork::getV_membrane(int i) const
+{
+	return getPotential(i, clock_);
+}
+
+unsigned int EventNetwork::getNumberSpikes(int i) const
+{
+	return nb_spikes_[i];
+}
+
+bool EventNetwork::getRefractoryState(int i) const
+{
+	return clock_ < last_[i];
+}
+
+unsigned int EventNetwork::getClock() const
+{
+	return clock_;
+}
+
+std::uint64_t EventNetwork::getNumberEvents() const
+{
+	return nb_events_;
+}
+
+void EventNetwork::getSpikes(std::vector<Spike>& spikes) const
+{
+	spikes.insert(spikes.end(), spikes_.begin(), spikes_.end());
+}
+
+void EventNetwork::setExternalInput(double external_input)
+{
+	//the potentials are computed up to now with the previous input
+	for (int i(0); i<nb_neurons_; ++i){
+		if (last_[i] < clock_){
+			V_membrane_[i] = getPotential(i, clock_);
+			last_[i] = clock_;
+		}
+	}
+	external_input_ = external_input;
+	V_inf_ = const2*external_input_/(1.0 - const1);
+	for (int i(0); i<nb_neurons_; ++i){
+		predictSpike(i);
+	}
+}
+
+void EventNetwork::setV_membrane(int i, double V_membrane)
+{
+	V_membrane_[i] = V_membrane;
+	last_[i] = clock_;
+	predictSpike(i);
+}
+
+void EventNetwork::setAmplitude(double J)
+{
+	amplitude_ = J;
+}
+
+void EventNetwork::setConnectivity(std::shared_ptr<const Connectivity> connectivity)
+{
+	assert(connectivity != nullptr);
+	assert(connectivity->getNumberNeurons() == nb_neurons_);
+	assert(connectivity->getNumberTargetNeurons() == nb_neurons_);
+	assert(not connectivity->hasDelays()); //the time buffers have D+1 boxes
+	connectivity_ = connectivity;
+}
+
+void EventNetwork::addConnections(unsigned int seed, int conn_e, int conn_i)
+{
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(nb_neurons_));
+	connectivity->addRandomConnections(nb_excitatory_, conn_e, conn_i, seed);
+	connectivity_ = connectivity;
+}
+
+void EventNetwork::update(double g, double pois, int nb_steps)
+{
+	assert(nb_steps >= 1);
+	spikes_.clear();
+	//the amplitudes are the same for every neuron of a population, they are computed once
+	const double ampl_e(amplitude_);
+	const double ampl_i(-g*amplitude_);
+	const double input(const2*external_input_);
+
+	//the external spikes received by all the neurons, each one is given to a random neuron
+	std::poisson_distribution<long long> dis_total (pois > 0.0 ? nb_neurons_*pois : 1.0);
+	std::uniform_int_distribution<> dis_neuron (0, std::max(0, nb_neurons_-1));
+
+	for (unsigned int step(clock_); step<clock_ + nb_steps*N; step += N){
+		if (pois > 0.0 and nb_neurons_ > 0){
+			for (long long k(dis_total(gen_)); k>0; --k){
+				receive(dis_neuron(gen_), step, amplitude_);
+			}
+		}
+
+		//the neurons crossing the threshold without input spike
+		const std::size_t first(spikes_.size());
+		while (not crossings_.empty() and crossings_.top().first <= step){
+			const int i(crossings_.top().second);
+			const unsigned int crossing(crossings_.top().first);
+			crossings_.pop();
+			//the events of the neurons that received something since are ignored
+			if (predicted_[i] == crossing){
+				assert(crossing == step);
+				spike(i, step);
+			}
+		}
+
+		//the neurons receiving amplitudes are updated, the others are not touched
+		const unsigned int box(step%(D+1));
+		for (auto const& i : received_[box]){
+			++nb_events_;
+			float& received(t_buffer_[box*nb_neurons_ + i]);
+			const double amplitude(received);
+			received = 0.0;
+			if (step < last_[i]){
+				continue; //refractory period
+			}
+			const double V(getPotential(i, step));
+			if (V > V_thr){
+				spike(i, step); //only if the rounding of the prediction was different
+				continue;
+			}
+			V_membrane_[i] = const1*V + input + amplitude;
+			last_[i] = step + N;
+			predictSpike(i);
+		}
+		received_[box].clear();
+
+		//the spikes are sent in the order of the neurons, they are received D time steps later
+		std::sort(spikes_.begin() + first, spikes_.end(), [](Spike const& a, Spike const& b){ return a.neuron < b.neuron; });
+		for (std::size_t k(first); k<spikes_.size(); ++k){
+			const int i(spikes_[k].neuron);
+			const double ampl(i < nb_excitatory_ ? ampl_e : ampl_i);
+			for (int t(0); t<connectivity_->getNumberTargets(i); ++t){
+				receive(connectivity_->getTarget(i, t), step + D, ampl*connectivity_->getWeight(i, t));
+			}
+		}
+	}
+	clock_ += nb_steps*N;
+}
+
+double EventNetwork::getPotential(int i, unsigned int step) const
+{
+	if (step < last_[i]){
+		return V_refractory;
+	}
+	if (step == last_[i]){
+		return V_membrane_[i];
+	}
+	//geometric decay towards V_inf since the last event
+	return V_inf_ + (V_membrane_[i] - V_inf_)*std::pow(const1, double(step - last_[i]));
+}
+
+void EventNetwork::predictSpike(int i)
+{
+	const double V(V_membrane_[i]);
+	if (V > V_thr){
+		//the threshold is crossed by the last update, the neuron spikes at the next time step
+		predicted_[i] = last_[i];
+	} else if (V_inf_ > V_thr){
+		//first time step n such that V_inf + (V - V_inf)*const1^n > V_thr
+		unsigned int n(std::max(1.0, std::floor(std::log((V_inf_ - V_thr)/(V_inf_ - V))/std::log(const1)) + 1.0));
+		//the rounding can move the crossing of one time step
+		while (n > 1 and getPotential(i, last_[i] + n - 1) > V_thr){
+			--n;
+		}
+		while (getPotential(i, last_[i] + n) <= V_thr){
+			++n;
+		}
+		predicted_[i] = last_[i] + n;
+	} else {
+		predicted_[i] = no_spike;
+		return;
+	}
+	crossings_.push(std::make_pair(predicted_[i], i));
+}
+
+void EventNetwork::spike(int i, unsigned int step)
+{
+	++nb_events_;
+	++nb_spikes_[i];
+	spikes_.push_back(Spike {step, i});
+	//the potential stays at V_refractory until the end of the refractory period
+	V_membrane_[i] = V_refractory;
+	last_[i] = step + tau_rp*N;
+	predictSpike(i);
+}
+
+void EventNetwork::receive(int i, unsigned int step, double amplitude)
+{
+	const unsigned int box(step%(D+1));
+	//a neuron is listed once per box, the steps are shifted to keep 0 for none
+	if (listed_[i] != step + 1){
+		listed_[i] = step + 1;
+		received_[box].push_back(i);
+	}
+	t_buffer_[box*nb_neurons_ + i] += amplitude;
+}
+
+EventNetwork::~EventNetwork()
+{}
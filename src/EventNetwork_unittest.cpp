@@ -0,0 +1,136 @@
+#include <iostream>
+#include "EventNetwork.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cassert>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if a neuron computed only at its events has the same potential as a neuron of Network
+ * at each time step, spikes at 92.4 milliseconds for an external input of 1.01 and stays refractory
+ * during tau_rp time steps
+*/
+
+TEST (EventNetworkTest, SameAsNetwork){
+	EventNetwork event(1, 0);
+	Network network(1, 0);
+	event.setExternalInput(1.01);
+	network.setExternalInput(1.01);
+	for (int t(0); t<1000; ++t){
+		event.update(5, 0.0);
+		network.update(5, 0.0);
+		EXPECT_NEAR (network.getV_membrane(0), event.getV_membrane(0), 1e-9);
+		EXPECT_EQ (network.getRefractoryState(0), event.getRefractoryState(0));
+		if (event.getClock() == 925){
+			std::vector<Spike> spikes;
+			event.getSpikes(spikes);
+			ASSERT_EQ (1u, spikes.size());
+			EXPECT_EQ (924u, spikes[0].step);
+		}
+	}
+	EXPECT_EQ (1u, event.getNumberSpikes(0));
+	EXPECT_LE (event.getNumberEvents(), 2u); //the spike and nothing else
+}
+
+/*
+ * TEST2: Test if the targets receive the excitatory and the inhibitory amplitudes with the correct delay
+*/
+
+TEST (EventNetworkTest, Delay){
+	EventNetwork network(2, 1);
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(3));
+	connectivity->addConnection(0, 1);
+	connectivity->addConnection(2, 1);
+	connectivity->build();
+	network.setConnectivity(connectivity);
+	network.setV_membrane(0, 21.0);
+	network.setV_membrane(2, 21.0);
+	network.update(5, 0.0);
+	EXPECT_EQ (1u, network.getNumberSpikes(0));
+	EXPECT_EQ (1u, network.getNumberSpikes(2));
+	for (int i(0); i<D; ++i){
+		EXPECT_NEAR (0.0, network.getV_membrane(1), 0.001);
+		network.update(5, 0.0);
+	}
+	EXPECT_NEAR (J_e - 5*J_e, network.getV_membrane(1), 0.001);
+}
+
+/*
+ * TEST3: Test if a connected network without noise gives the same spikes as Network
+*/
+
+TEST (EventNetworkTest, SameSpikes){
+	EventNetwork event(400, 100);
+	Network network(400, 100);
+	network.addConnections(41, 40, 10);
+	event.setConnectivity(network.getConnectivity());
+	event.setExternalInput(1.01);
+	network.setExternalInput(1.01);
+	for (int i(0); i<500; ++i){
+		//the neurons start at different potentials so they don't spike together
+		event.setV_membrane(i, 0.04*i);
+		network.setV_membrane(i, 0.04*i);
+	}
+	std::vector<Spike> event_spikes, network_spikes;
+	for (int t(0); t<200; ++t){
+		event.update(5, 0.0, D);
+		network.update(5, 0.0, D);
+		event.getSpikes(event_spikes);
+		network.getSpikes(network_spikes);
+	}
+	ASSERT_EQ (network_spikes.size(), event_spikes.size());
+	EXPECT_GT (event_spikes.size(), 500u);
+	for (size_t k(0); k<event_spikes.size(); ++k){
+		EXPECT_EQ (network_spikes[k].step, event_spikes[k].step);
+		EXPECT_EQ (network_spikes[k].neuron, event_spikes[k].neuron);
+	}
+}
+
+/*
+ * TEST4: Test if the noises drawn for the whole network give the same firing rate as the noises
+ * drawn for each neuron
+*/
+
+TEST (EventNetworkTest, Noise){
+	EventNetwork event(1000, 0, 3);
+	Network network(1000, 0, 3);
+	for (int t(0); t<1000; ++t){
+		event.update(5, 0.9, D);
+		network.update(5, 0.9, D);
+	}
+	unsigned int event_spikes(0), network_spikes(0);
+	for (int i(0); i<1000; ++i){
+		event_spikes += event.getNumberSpikes(i);
+		network_spikes += network.getNumberSpikes(i);
+	}
+	EXPECT_GT (network_spikes, 1000u);
+	EXPECT_NEAR (1.0, double(event_spikes)/network_spikes, 0.05);
+}
+
+/*
+ * TEST5: Test if the neurons receiving nothing are never updated
+*/
+
+TEST (EventNetworkTest, Events){
+	EventNetwork network(1000, 0);
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(1000));
+	for (int i(1); i<=100; ++i){
+		connectivity->addConnection(0, 10*i - 1);
+	}
+	connectivity->build();
+	network.setConnectivity(connectivity);
+	network.setV_membrane(0, 21.0); //one spike received by 100 neurons
+	for (int t(0); t<100; ++t){
+		network.update(5, 0.0, D);
+	}
+	EXPECT_EQ (1u, network.getNumberSpikes(0));
+	EXPECT_EQ (101u, network.getNumberEvents());
+	EXPECT_EQ (100u*D, network.getClock());
+}
@@ -0,0 +1,43 @@
+#include "HugePageAllocator.hpp"
+#include <new>
+#include <cstdint>
+#include <sys/mman.h>
+
+//the mapped blocks are rounded to a whole number of huge pages
+static std::size_t roundLarge(std::size_t bytes)
+{
+	return (bytes + huge_page_size - 1)/huge_page_size*huge_page_size;
+}
+
+void* allocateLarge(std::size_t bytes)
+{
+	if (bytes < huge_page_size){
+		return ::operator new(bytes);
+	}
+	const std::size_t size(roundLarge(bytes));
+	//one more huge page is mapped to find an aligned block inside, the rest is unmapped
+	void* mapping(mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+	if (mapping == MAP_FAILED){
+		throw std::bad_alloc();
+	}
+	char* begin(static_cast<char*>(mapping));
+	char* block(reinterpret_cast<char*>(roundLarge(reinterpret_cast<std::uintptr_t>(begin))));
+	if (block > begin){
+		munmap(begin, block - begin);
+	}
+	munmap(block + size, begin + huge_page_size - block);
+#ifdef MADV_HUGEPAGE
+	//the advice fails without error if the huge pages are disabled, the block then uses normal pages
+	madvise(block, size, MADV_HUGEPAGE);
+#endif
+	return block;
+}
+
+void releaseLarge(void* block, std::size_t bytes)
+{
+	if (bytes < huge_page_size){
+		::operator delete(block);
+		return;
+	}
+	munmap(block, roundLarge(bytes));
+}
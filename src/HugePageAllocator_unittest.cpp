@@ -0,0 +1,40 @@
+#include <iostream>
+#include <cstdint>
+#include "HugePageAllocator.hpp"
+#include "gtest/gtest.h"
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if a big array is aligned on a huge page and keeps its values when the vector grows
+*/
+
+TEST (HugePageAllocatorTest, Large){
+	LargeVector<std::uint32_t> values(huge_page_size/sizeof(std::uint32_t) + 1, 7);
+	EXPECT_EQ (0u, reinterpret_cast<std::uintptr_t>(values.data()) % huge_page_size);
+	values[values.size() - 1] = 3;
+	values.resize(3*values.size(), 1); //a new block is mapped and the old one released
+	EXPECT_EQ (0u, reinterpret_cast<std::uintptr_t>(values.data()) % huge_page_size);
+	EXPECT_EQ (7u, values[0]);
+	EXPECT_EQ (3u, values[huge_page_size/sizeof(std::uint32_t)]);
+	EXPECT_EQ (1u, values.back());
+}
+
+/*
+ * TEST2: Test if the small arrays are allocated normally and can be copied
+*/
+
+TEST (HugePageAllocatorTest, Small){
+	LargeVector<double> values(100, 0.5);
+	LargeVector<double> copy(values);
+	copy.push_back(1.0);
+	EXPECT_EQ (100u, values.size());
+	EXPECT_EQ (101u, copy.size());
+	EXPECT_EQ (0.5, copy[99]);
+}
@@ -0,0 +1,225 @@
+#include "MembraneKernel.hpp"
+#include "Neuron.hpp"
+#include <cassert>
+#include <cstring>
+
+static_assert(tau_rp <= 255, "the refractory counters are stored on 8 bits");
+
+#if defined(__GNUC__) and defined(__x86_64__)
+#define VECTOR_KERNELS
+#include <immintrin.h>
+//the multiplication and the additions must not be fused, so the vector kernels give the same potentials as the scalar one
+#define VECTOR_KERNEL(instructions) __attribute__((target(instructions), optimize("fp-contract=off")))
+#endif
+
+
+/*!
+ * @brief Update one neuron of a block during one time step
+ * @details The membrane equation is computed in the same order as Neuron::update,
+ * so the kernels give exactly the same membrane potentials.
+ *
+ * @param block : the arrays of the neurons
+ * @param k : an integer indicating the index of the neuron in the block
+ * @param spiking : the compact list of the spiking neurons
+ * @param nb_spiking : an integer indicating the number of spiking neurons, increased if the neuron spikes
+ */
+static inline void integrateNeuron(MembraneBlock const& block, int k, int* spiking, int& nb_spiking)
+{
+	block.spike[k] = 0;
+	//if the membrane potential crosses the threshold, the neuron spikes
+	if (block.V_membrane[k] > V_thr){
+		block.spike[k] = 1;
+		++block.nb_spikes[k];
+		block.refractory[k] = tau_rp;
+		spiking[nb_spiking++] = k;
+	}
+	if (block.refractory[k] > 0){
+		block.V_membrane[k] = V_refractory;
+		--block.refractory[k];
+	} else {
+		block.V_membrane[k] = const1*block.V_membrane[k] + block.input + block.box[k] + block.noise[k];
+	}
+	//the box is resetted to 0 after each update to allow the next spikes to be stored
+	block.box[k] = 0.0;
+}
+
+/*!
+ * @brief Update the neurons of a block one after the other
+ */
+static int integrateScalar(MembraneBlock const& block, int* spiking)
+{
+	int nb_spiking(0);
+	for (int k(0); k<block.size; ++k){
+		integrateNeuron(block, k, spiking, nb_spiking);
+	}
+	return nb_spiking;
+}
+
+#ifdef VECTOR_KERNELS
+
+/*!
+ * @brief Update the neurons of a block 4 by 4 with the AVX2 instructions
+ * @details The threshold and the refractory period are masks, the potential of the refractory neurons
+ * is chosen by a blend instead of a branch.
+ */
+VECTOR_KERNEL("avx2")
+static int integrateAVX2(MembraneBlock const& block, int* spiking)
+{
+	const __m256d threshold (_mm256_set1_pd(V_thr));
+	const __m256d refractory_V (_mm256_set1_pd(V_refractory));
+	const __m256d c1 (_mm256_set1_pd(const1));
+	const __m256d input (_mm256_set1_pd(block.input));
+	const __m128i period (_mm_set1_epi32(tau_rp));
+	const __m128i zero (_mm_setzero_si128());
+	//the lower half of each mask of 64 bits gives the mask of 32 bits of the integers
+	const __m256i lower (_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+
+	int nb_spiking(0);
+	int k(0);
+	for (; k+4<=block.size; k += 4){
+		const __m256d V (_mm256_loadu_pd(block.V_membrane + k));
+		const __m256d spikes (_mm256_cmp_pd(V, threshold, _CMP_GT_OQ));
+		const __m128i spikes32 (_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(spikes), lower)));
+
+		//the 4 counters of 8 bits are extended to 32 bits
+		int bytes;
+		std::memcpy(&bytes, block.refractory + k, sizeof(bytes));
+		__m128i refractory (_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)));
+		refractory = _mm_blendv_epi8(refractory, period, spikes32);
+		const __m128i in_period (_mm_cmpgt_epi32(refractory, zero));
+		//the counters of the refractory neurons decrease, the mask is -1
+		refractory = _mm_add_epi32(refractory, in_period);
+		bytes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packus_epi32(refractory, zero), zero));
+		std::memcpy(block.refractory + k, &bytes, sizeof(bytes));
+		__m128i nb_spikes (_mm_loadu_si128(reinterpret_cast<const __m128i*>(block.nb_spikes + k)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(block.nb_spikes + k), _mm_sub_epi32(nb_spikes, spikes32));
+
+		__m256d new_V (_mm256_add_pd(_mm256_mul_pd(c1, V), input));
+		//the 4 amplitudes are converted exactly to doubles
+		new_V = _mm256_add_pd(new_V, _mm256_cvtps_pd(_mm_loadu_ps(block.box + k)));
+		new_V = _mm256_add_pd(new_V, _mm256_loadu_pd(block.noise + k));
+		const __m256d refractory_mask (_mm256_castsi256_pd(_mm256_cvtepi32_epi64(in_period)));
+		_mm256_storeu_pd(block.V_membrane + k, _mm256_blendv_pd(new_V, refractory_V, refractory_mask));
+		_mm_storeu_ps(block.box + k, _mm_setzero_ps());
+
+		//the spiking neurons are taken from the bits of the mask
+		int bits(_mm256_movemask_pd(spikes));
+		for (int j(0); j<4; ++j){
+			block.spike[k+j] = (bits >> j) & 1;
+		}
+		while (bits != 0){
+			spiking[nb_spiking++] = k + __builtin_ctz(bits);
+			bits &= bits - 1;
+		}
+	}
+	for (; k<block.size; ++k){
+		integrateNeuron(block, k, spiking, nb_spiking);
+	}
+	return nb_spiking;
+}
+
+/*!
+ * @brief Update the neurons of a block 8 by 8 with the AVX-512 instructions
+ * @details The masks are mask registers, the spiking neurons are written by a compress store.
+ */
+VECTOR_KERNEL("avx512f,avx512vl,avx512bw")
+static int integrateAVX512(MembraneBlock const& block, int* spiking)
+{
+	const __m512d threshold (_mm512_set1_pd(V_thr));
+	const __m512d refractory_V (_mm512_set1_pd(V_refractory));
+	const __m512d c1 (_mm512_set1_pd(const1));
+	const __m512d input (_mm512_set1_pd(block.input));
+	const __m256i period (_mm256_set1_epi32(tau_rp));
+	const __m256i one (_mm256_set1_epi32(1));
+	const __m256i zero (_mm256_setzero_si256());
+	const __m128i spike_bytes (_mm_set1_epi8(1));
+	const __m256i lanes (_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+	int nb_spiking(0);
+	int k(0);
+	for (; k+8<=block.size; k += 8){
+		const __m512d V (_mm512_loadu_pd(block.V_membrane + k));
+		const __mmask8 spikes (_mm512_cmp_pd_mask(V, threshold, _CMP_GT_OQ));
+
+		__m256i refractory (_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.refractory + k))));
+		refractory = _mm256_mask_mov_epi32(refractory, spikes, period);
+		const __mmask8 in_period (_mm256_cmpgt_epi32_mask(refractory, zero));
+		//the counters are truncated to 8 bits again
+		_mm256_mask_cvtepi32_storeu_epi8(block.refractory + k, 0xFF,
+										 _mm256_mask_sub_epi32(refractory, in_period, refractory, one));
+		const __m256i nb_spikes (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block.nb_spikes + k)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(block.nb_spikes + k),
+							_mm256_mask_add_epi32(nb_spikes, spikes, nb_spikes, one));
+
+		__m512d new_V (_mm512_add_pd(_mm512_mul_pd(c1, V), input));
+		//the amplitudes are converted to doubles in all the lanes of the mask
+		new_V = _mm512_add_pd(new_V, _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(block.box + k)));
+		new_V = _mm512_add_pd(new_V, _mm512_loadu_pd(block.noise + k));
+		_mm512_storeu_pd(block.V_membrane + k, _mm512_mask_mov_pd(new_V, in_period, refractory_V));
+		_mm256_storeu_ps(block.box + k, _mm256_setzero_ps());
+
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(block.spike + k), _mm_maskz_mov_epi8(spikes, spike_bytes));
+		_mm256_mask_compressstoreu_epi32(spiking + nb_spiking, spikes, _mm256_add_epi32(lanes, _mm256_set1_epi32(k)));
+		nb_spiking += __builtin_popcount(spikes);
+	}
+	for (; k<block.size; ++k){
+		integrateNeuron(block, k, spiking, nb_spiking);
+	}
+	return nb_spiking;
+}
+
+#endif
+
+bool isSupported(Instructions instructions)
+{
+#ifdef VECTOR_KERNELS
+	switch (instructions){
+		case Instructions::avx512:
+			return __builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512vl")
+				   and __builtin_cpu_supports("avx512bw");
+		case Instructions::avx2:
+			return __builtin_cpu_supports("avx2");
+		default:
+			return true;
+	}
+#else
+	return instructions == Instructions::scalar;
+#endif
+}
+
+Instructions getBestInstructions()
+{
+	if (isSupported(Instructions::avx512)){
+		return Instructions::avx512;
+	}
+	if (isSupported(Instructions::avx2)){
+		return Instructions::avx2;
+	}
+	return Instructions::scalar;
+}
+
+std::string getName(Instructions instructions)
+{
+	switch (instructions){
+		case Instructions::avx512:
+			return "avx512";
+		case Instructions::avx2:
+			return "avx2";
+		default:
+			return "scalar";
+	}
+}
+
+MembraneKernel getMembraneKernel(Instructions instructions)
+{
+	assert(isSupported(instructions));
+#ifdef VECTOR_KERNELS
+	if (instructions == Instructions::avx512){
+		return integrateAVX512;
+	}
+	if (instructions == Instructions::avx2){
+		return integrateAVX2;
+	}
+#endif
+	return integrateScalar;
+}
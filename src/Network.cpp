@@ -0,0 +1,502 @@
+#include "Network.hpp"
+#include "Profiler.hpp"
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(CheckpointHeader) == 72, "the header of a checkpoint file has 72 bytes");
+
+
+/*!
+ * @brief Write an array in a checkpoint file, followed by zeros up to a multiple of 8 bytes
+ *
+ * @param file : the checkpoint file
+ * @param data : the first value of the array
+ * @param size : an integer indicating the number of values
+ */
+template <typename Value>
+static void writeArray(std::ofstream& file, const Value* data, std::size_t size)
+{
+	const std::size_t bytes(size*sizeof(Value));
+	file.write(reinterpret_cast<const char*>(data), bytes);
+	const char padding[8] = {0};
+	file.write(padding, (8 - bytes%8)%8);
+}
+
+/*!
+ * @brief Copy an array of a mapped checkpoint file and move to the next array
+ *
+ * @param data : the position of the array in the file, moved after its padding
+ * @param end : the end of the file
+ * @param values : the first value where the array is copied
+ * @param size : an integer indicating the number of values
+ */
+template <typename Value>
+static void readArray(const char*& data, const char* end, Value* values, std::size_t size)
+{
+	const std::size_t bytes(size*sizeof(Value));
+	assert(std::size_t(end - data) >= bytes); //check if the file is complete
+	std::memcpy(values, data, bytes);
+	data += bytes + (8 - bytes%8)%8;
+}
+
+
+Network::Network(int nb_excitatory, int nb_inhibitory, unsigned int seed)
+: nb_neurons_(nb_excitatory + nb_inhibitory),
+  nb_excitatory_(nb_excitatory),
+  clock_(t_start),
+  external_input_(0.0),
+  amplitude_(J_e),
+  min_delay_(D),
+  max_delay_(0),
+  V_membrane_(nb_neurons_, 0.0),
+  refractory_(nb_neurons_, 0),
+  spike_(nb_neurons_, 0),
+  nb_spikes_(nb_neurons_, 0),
+  connectivity_(std::make_shared<Connectivity>(nb_neurons_)),
+  pool_(new ThreadPool(1)),
+  instructions_(getBestInstructions()),
+  kernel_(getMembraneKernel(instructions_)),
+  noise_(0.0, seed),
+  partition_spikes_((nb_neurons_ + partition_size - 1)/partition_size),
+  partition_potentials_(partition_spikes_.size(), 0.0)
+{
+	assert(nb_excitatory >= 0 and nb_inhibitory >= 0);
+	setMaxDelay(D);
+#ifdef PROFILING
+	integration_time_ = 0.0;
+	delivery_time_ = 0.0;
+	deliveries_.assign(1, 0);
+#endif
+}
+
+int Network::getNumberNeurons() const
+{
+	return nb_neurons_;
+}
+
+int Network::getNumberExcitatory() const
+{
+	return nb_excitatory_;
+}
+
+double Network::getV_membrane(int i) const
+{
+	return V_membrane_[i];
+}
+
+double Network::getMeanV_membrane() const
+{
+	double sum(0.0);
+	for (auto const& V : partition_potentials_){
+		sum += V;
+	}
+	return nb_neurons_ > 0 ? sum/nb_neurons_ : 0.0;
+}
+
+unsigned int Network::getNumberSpikes(int i) const
+{
+	return nb_spikes_[i];
+}
+
+bool Network::getSpikeState(int i) const
+{
+	return spike_[i];
+}
+
+bool Network::getRefractoryState(int i) const
+{
+	return refractory_[i] > 0;
+}
+
+Instructions Network::getInstructions() const
+{
+	return instructions_;
+}
+
+double Network::getAmplitude() const
+{
+	return amplitude_;
+}
+
+double Network::getTimeBuffer(int i, int box) const
+{
+	assert(box >= 0 and box <= max_delay_);
+	return t_buffer_[box*nb_neurons_ + i];
+}
+
+int Network::getMinDelay() const
+{
+	return min_delay_;
+}
+
+int Network::getMaxDelay() const
+{
+	return max_delay_;
+}
+
+std::shared_ptr<const Connectivity> Network::getConnectivity() const
+{
+	return connectivity_;
+}
+
+unsigned int Network::getClock() const
+{
+	return clock_;
+}
+
+int Network::getNumberThreads() const
+{
+	return pool_->getNumberThreads();
+}
+
+std::size_t Network::getMemory() const
+{
+	return V_membrane_.size()*sizeof(double) + refractory_.size()*sizeof(std::uint8_t) + spike_.size()*sizeof(char)
+		   + nb_spikes_.size()*sizeof(unsigned int) + t_buffer_.size()*sizeof(float);
+}
+
+void Network::getSpikes(std::vector<Spike>& spikes) const
+{
+	spikes.insert(spikes.end(), spikes_.begin(), spikes_.end());
+}
+
+std::vector<Spike> const& Network::getLastSpikes() const
+{
+	return spikes_;
+}
+
+#ifdef PROFILING
+double Network::getIntegrationTime() const
+{
+	return integration_time_;
+}
+
+double Network::getDeliveryTime() const
+{
+	return delivery_time_;
+}
+
+std::uint64_t Network::getNumberDeliveries() const
+{
+	std::uint64_t total(0);
+	for (auto const& d : deliveries_){
+		total += d;
+	}
+	return total;
+}
+#endif
+
+Neuron Network::getNeuron(int i) const
+{
+	assert(max_delay_ == D); //the time buffer of a Neuron has D+1 boxes
+	//the spike occured tau_rp - refractory_ steps before the current clock
+	double t_spike(0.0);
+	if (refractory_[i] > 0){
+		t_spike = (clock_ - (tau_rp - refractory_[i]))*h;
+	}
+	Neuron n(i < nb_excitatory_, V_membrane_[i], nb_spikes_[i], t_spike,
+			 spike_[i], clock_, external_input_, refractory_[i] > 0);
+	for (int box(0); box <= D; ++box){
+		n.setTimeBuffer(box, getTimeBuffer(i, box));
+	}
+	return n;
+}
+
+void Network::setExternalInput(double external_input)
+{
+	external_input_ = external_input;
+}
+
+void Network::setInstructions(Instructions instructions)
+{
+	kernel_ = getMembraneKernel(instructions);
+	instructions_ = instructions;
+}
+
+void Network::setAmplitude(double J)
+{
+	amplitude_ = J;
+}
+
+void Network::setV_membrane(int i, double V_membrane)
+{
+	V_membrane_[i] = V_membrane;
+	sumPotentials(i/partition_size);
+}
+
+void Network::setNumberThreads(int nb_threads)
+{
+	pool_.reset(new ThreadPool(nb_threads));
+}
+
+void Network::setConnectivity(std::shared_ptr<const Connectivity> connectivity)
+{
+	assert(connectivity != nullptr);
+	assert(connectivity->getNumberNeurons() == nb_neurons_);
+	assert(connectivity->getNumberTargetNeurons() == nb_neurons_); //all the neurons receive their connections
+	connectivity_ = connectivity;
+	min_delay_ = connectivity->getMinDelay();
+	if (connectivity->getMaxDelay() > max_delay_){
+		setMaxDelay(connectivity->getMaxDelay());
+	}
+}
+
+void Network::addConnections(unsigned int seed, int conn_e, int conn_i)
+{
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(nb_neurons_));
+	connectivity->addRandomConnections(nb_excitatory_, conn_e, conn_i, seed, pool_->getNumberThreads());
+	connectivity_ = connectivity;
+	min_delay_ = D;
+}
+
+void Network::saveCheckpoint(std::string const& file_name) const
+{
+	CheckpointHeader header;
+	std::memcpy(header.magic, "BRUNELCK", sizeof(header.magic));
+	header.version = 7;
+	header.nb_neurons = nb_neurons_;
+	header.nb_excitatory = nb_excitatory_;
+	header.delay = max_delay_;
+	header.seed = noise_.getSeed();
+	header.narrow = connectivity_->isNarrow();
+	header.clock = clock_;
+	header.nb_connections = connectivity_->getNumberConnections();
+	header.external_input = external_input_;
+	header.amplitude = amplitude_;
+	header.weighted = connectivity_->hasWeights();
+	header.delayed = connectivity_->hasDelays();
+
+	//each array is written at once, the file is written sequentially in a temporary file
+	//which replaces the previous checkpoint only when it's complete
+	const std::string temporary (file_name + ".tmp");
+	std::ofstream file (temporary.c_str(), std::ios::binary);
+	assert(not file.fail()); //check if the file opens correctly
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	writeArray(file, V_membrane_.data(), V_membrane_.size());
+	writeArray(file, refractory_.data(), refractory_.size());
+	writeArray(file, spike_.data(), spike_.size());
+	writeArray(file, nb_spikes_.data(), nb_spikes_.size());
+	writeArray(file, t_buffer_.data(), t_buffer_.size());
+	writeArray(file, connectivity_->getOffsets(), nb_neurons_+1);
+	if (connectivity_->isNarrow()){
+		writeArray(file, connectivity_->getNarrowTargets(), header.nb_connections);
+	} else {
+		writeArray(file, connectivity_->getWideTargets(), header.nb_connections);
+	}
+	if (header.weighted){
+		writeArray(file, connectivity_->getWeights(), header.nb_connections);
+	}
+	if (header.delayed){
+		writeArray(file, connectivity_->getDelays(), header.nb_connections);
+	}
+	file.close();
+	assert(not file.fail()); //check if the file is written correctly
+	std::rename(temporary.c_str(), file_name.c_str());
+}
+
+void Network::loadCheckpoint(std::string const& file_name)
+{
+	const int file(::open(file_name.c_str(), O_RDONLY));
+	assert(file >= 0); //check if the file opens correctly
+	struct stat status;
+	fstat(file, &status);
+	const std::size_t size(status.st_size);
+	assert(size >= sizeof(CheckpointHeader));
+	void* mapping(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0));
+	assert(mapping != MAP_FAILED);
+	//the file is read from the beginning to the end
+	madvise(mapping, size, MADV_SEQUENTIAL);
+	const char* data(static_cast<const char*>(mapping));
+	const char* end(data + size);
+
+	CheckpointHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	data += sizeof(header);
+	assert(std::memcmp(header.magic, "BRUNELCK", 8) == 0 and header.version == 7);
+	//the network must have the same neurons
+	assert(int(header.nb_neurons) == nb_neurons_ and int(header.nb_excitatory) == nb_excitatory_);
+	assert(header.delay >= D and header.delay <= max_delay);
+
+	clock_ = header.clock;
+	external_input_ = header.external_input;
+	amplitude_ = header.amplitude;
+	readArray(data, end, V_membrane_.data(), V_membrane_.size());
+	for (size_t p(0); p<partition_potentials_.size(); ++p){
+		sumPotentials(p);
+	}
+	readArray(data, end, refractory_.data(), refractory_.size());
+	readArray(data, end, spike_.data(), spike_.size());
+	readArray(data, end, nb_spikes_.data(), nb_spikes_.size());
+	//the boxes are stored by time step modulo their number, they are read without moving them
+	max_delay_ = header.delay;
+	t_buffer_.resize((max_delay_+1)*nb_neurons_);
+	rows_.resize(2*max_delay_+1);
+	for (size_t j(0); j<rows_.size(); ++j){
+		rows_[j] = (j%(max_delay_+1))*nb_neurons_;
+	}
+	readArray(data, end, t_buffer_.data(), t_buffer_.size());
+
+	//the connections are used directly in the mapped file to build the new structure
+	const std::size_t* offsets(reinterpret_cast<const std::size_t*>(data));
+	data += (nb_neurons_+1)*sizeof(std::size_t);
+	const std::size_t targets_size(header.nb_connections*(header.narrow ? sizeof(std::uint16_t) : sizeof(std::uint32_t)));
+	assert(data + targets_size <= end and offsets[nb_neurons_] == header.nb_connections);
+	const char* targets(data);
+	data += targets_size + (8 - targets_size%8)%8;
+	const float* weights(nullptr);
+	if (header.weighted){
+		weights = reinterpret_cast<const float*>(data);
+		const std::size_t weights_size(header.nb_connections*sizeof(float));
+		assert(data + weights_size <= end);
+		data += weights_size + (8 - weights_size%8)%8;
+	}
+	const std::uint8_t* delays(nullptr);
+	if (header.delayed){
+		delays = reinterpret_cast<const std::uint8_t*>(data);
+		assert(data + header.nb_connections <= end);
+		data += header.nb_connections + (8 - header.nb_connections%8)%8;
+	}
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(nb_neurons_));
+	assert(connectivity->isNarrow() == bool(header.narrow));
+	connectivity->assign(offsets, targets, weights, delays);
+	assert(connectivity->getMaxDelay() <= max_delay_);
+	connectivity_ = connectivity;
+	min_delay_ = connectivity->getMinDelay();
+
+	noise_.setSeed(header.seed);
+
+	for (auto& spikes : partition_spikes_){
+		spikes.clear();
+	}
+	spikes_.clear();
+	munmap(mapping, size);
+	::close(file);
+}
+
+void Network::update(double g, double pois, int nb_steps)
+{
+	assert(nb_steps >= 1 and nb_steps <= min_delay_);
+#ifdef PROFILING
+	const double start(Profiler::now());
+#endif
+	//the partitions are independent during the update of the neurons,
+	//without noises the loop doesn't have to draw random numbers
+	noise_.setLambda(std::max(0.0, pois));
+	pool_->run(partition_spikes_.size(), [=](int p){ updatePartition(p, nb_steps, pois > 0.0); });
+	mergeSpikes();
+
+#ifdef PROFILING
+	const double integrated(Profiler::now());
+	integration_time_ = integrated - start;
+#endif
+
+	//the amplitudes are the same for every neuron of a population, they are computed once
+	const double ampl_e(amplitude_);
+	const double ampl_i(-g*amplitude_);
+	//each group of partitions writes only in the time buffers of its own neurons, one group per thread
+	const int nb_groups(std::min<int>(pool_->getNumberThreads(), partition_spikes_.size()));
+	positions_.resize(nb_groups);
+#ifdef PROFILING
+	deliveries_.assign(nb_groups, 0);
+#endif
+	pool_->run(nb_groups, [=](int group){ deliverGroup(group, nb_groups, ampl_e, ampl_i); });
+	clock_ += nb_steps*N;
+#ifdef PROFILING
+	delivery_time_ = Profiler::now() - integrated;
+#endif
+}
+
+void Network::updatePartition(int p, int nb_steps, bool noise)
+{
+	const int begin(p*partition_size);
+	const int end(std::min(begin + partition_size, nb_neurons_));
+
+	std::vector<Spike>& spikes(partition_spikes_[p]);
+	spikes.clear();
+
+	MembraneBlock block {&V_membrane_[begin], &refractory_[begin], &spike_[begin], &nb_spikes_[begin],
+						 nullptr, nullptr, end - begin, const2*external_input_};
+	::updatePartition(kernel_, block, &t_buffer_[begin], rows_.data(), max_delay_+1, noise ? &noise_ : nullptr,
+					  amplitude_, begin, clock_, nb_steps, spikes);
+	//the potentials are still in the cache
+	sumPotentials(p);
+}
+
+void Network::sumPotentials(int p)
+{
+	const int begin(p*partition_size);
+	const int end(std::min(begin + partition_size, nb_neurons_));
+	double sum(0.0);
+	for (int i(begin); i<end; ++i){
+		sum += V_membrane_[i];
+	}
+	partition_potentials_[p] = sum;
+}
+
+void Network::setMaxDelay(int max_delay)
+{
+	assert(max_delay >= D and max_delay <= ::max_delay);
+	//the box of a time step is at the step modulo the number of boxes, the boxes of the
+	//time steps clock_ to clock_+max_delay_ are still to be read, the others are empty
+	LargeVector<float> t_buffer(nb_neurons_*(max_delay+1), 0.0);
+	for (unsigned int step(clock_); not t_buffer_.empty() and step<=clock_ + max_delay_; ++step){
+		std::copy(t_buffer_.begin() + (step%(max_delay_+1))*nb_neurons_,
+				  t_buffer_.begin() + (step%(max_delay_+1) + 1)*nb_neurons_,
+				  t_buffer.begin() + (step%(max_delay+1))*nb_neurons_);
+	}
+	t_buffer_.swap(t_buffer);
+	max_delay_ = max_delay;
+	rows_.resize(2*max_delay_+1);
+	for (size_t j(0); j<rows_.size(); ++j){
+		rows_[j] = (j%(max_delay_+1))*nb_neurons_;
+	}
+}
+
+void Network::mergeSpikes()
+{
+	spikes_.clear();
+	//the spikes of each partition are sorted by time step, they are merged step by step
+	std::vector<size_t> next(partition_spikes_.size(), 0);
+	bool remaining(true);
+	while (remaining){
+		remaining = false;
+		unsigned int step(0);
+		for (size_t p(0); p<partition_spikes_.size(); ++p){
+			if (next[p] < partition_spikes_[p].size() and (not remaining or partition_spikes_[p][next[p]].step < step)){
+				step = partition_spikes_[p][next[p]].step;
+				remaining = true;
+			}
+		}
+		for (size_t p(0); p<partition_spikes_.size(); ++p){
+			for (; next[p] < partition_spikes_[p].size() and partition_spikes_[p][next[p]].step == step; ++next[p]){
+				spikes_.push_back(partition_spikes_[p][next[p]]);
+			}
+		}
+	}
+}
+
+void Network::deliverGroup(int group, int nb_groups, double ampl_e, double ampl_i)
+{
+	const int nb_partitions(partition_spikes_.size());
+	const int first(group*nb_partitions/nb_groups);
+	const int last((group + 1)*nb_partitions/nb_groups);
+	const std::uint64_t nb_deliveries(deliverSpikes(*connectivity_, spikes_, t_buffer_.data(), rows_.data(),
+												   max_delay_+1, nb_neurons_, nb_excitatory_, first, last,
+												   positions_[group], ampl_e, ampl_i));
+#ifdef PROFILING
+	deliveries_[group] = nb_deliveries;
+#else
+	(void)nb_deliveries;
+#endif
+}
+
+Network::~Network()
+{}
@@ -0,0 +1,503 @@
+#include <iostream>
+#include "Network.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cassert>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if a neuron of the network follows the membrane equation exactly as an object Neuron
+ * and spikes at 92.4 milliseconds for an external input of 1.01.
+*/
+
+TEST (NetworkTest, SameAsNeuron){
+	Network network(1, 0); //one excitatory neuron
+	Neuron neuron(true);
+	network.setExternalInput(1.01);
+	neuron.setExternalInput(1.01);
+	do {
+		network.update(5, 0.0); //no noise
+		neuron.update(1, 0.0, 5);
+		EXPECT_EQ (neuron.getV_membrane(), network.getV_membrane(0)); //same equation, same order of operations
+		EXPECT_EQ (neuron.getSpikeState(), network.getSpikeState(0));
+	} while (network.getClock() < 925);
+	EXPECT_EQ (1u, network.getNumberSpikes(0)); //the neuron has spiked at time 924
+	EXPECT_TRUE (network.getRefractoryState(0));
+	//the copy of the neuron knows when the last spike occured
+	EXPECT_NEAR (92.4, network.getNeuron(0).getTimeSpike(), 0.001);
+}
+
+/*
+ * TEST2: Test if the neuron stays in its refractory period during tau_rp time steps
+*/
+
+TEST (NetworkTest, RefractoryPeriod){
+	Network network(1, 0);
+	network.setExternalInput(1.01);
+	do {
+		network.update(5, 0.0);
+	} while (not network.getSpikeState(0));
+	for (int i(1); i<tau_rp; ++i){
+		EXPECT_TRUE (network.getRefractoryState(0));
+		network.update(5, 0.0);
+		EXPECT_NEAR (0.0, network.getV_membrane(0), 0.001);
+	}
+	network.update(5, 0.0); //first update after the refractory period
+	EXPECT_FALSE (network.getRefractoryState(0));
+	EXPECT_NEAR (20.0*(1.0-exp(-0.1/20.0)), network.getV_membrane(0), 0.001);
+}
+
+/*
+ * TEST3: Test if the targets receive the excitatory and the inhibitory amplitudes with the correct delay
+*/
+
+TEST (NetworkTest, Delay){
+	Network network(2, 1); //neurons 0 and 1 are excitatory, neuron 2 is inhibitory
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(3));
+	connectivity->addConnection(0, 1);
+	connectivity->addConnection(2, 1);
+	connectivity->build();
+	network.setConnectivity(connectivity);
+	network.setV_membrane(0, 21.0); //both sources are above the threshold and will spike at the next update
+	network.setV_membrane(2, 21.0);
+	network.update(5, 0.0);
+	EXPECT_TRUE (network.getSpikeState(0));
+	EXPECT_TRUE (network.getSpikeState(2));
+	//the target receives nothing before the delay
+	for (int i(0); i<D; ++i){
+		EXPECT_NEAR (0.0, network.getV_membrane(1), 0.001);
+		network.update(5, 0.0);
+	}
+	EXPECT_NEAR (J_e - 5*J_e, network.getV_membrane(1), 0.001);
+}
+
+/*
+ * TEST4: Test if every neuron receives exactly 1000 excitatory connections and 250 inhibitory connections
+*/
+
+TEST (NetworkTest, Connections){
+	Connectivity connectivity;
+	connectivity.addRandomConnections(excitatory_neurons, c_e, c_i, 1);
+	EXPECT_TRUE (connectivity.isNarrow()); //12500 neurons fit on 16 bits
+	EXPECT_EQ (12500u*1250u, connectivity.getNumberConnections());
+	//count the connections received by each neuron from each population
+	std::vector<int> received_e(total_neurons, 0), received_i(total_neurons, 0);
+	for (int i(0); i<total_neurons; ++i){
+		for (int k(0); k<connectivity.getNumberTargets(i); ++k){
+			if (i < excitatory_neurons){
+				++received_e[connectivity.getTarget(i, k)];
+			} else {
+				++received_i[connectivity.getTarget(i, k)];
+			}
+		}
+	}
+	for (int j(0); j<total_neurons; ++j){
+		EXPECT_EQ (1000, received_e[j]);
+		EXPECT_EQ (250, received_i[j]);
+	}
+	//the same seed gives the same network
+	Connectivity same;
+	same.addRandomConnections(excitatory_neurons, c_e, c_i, 1);
+	for (int k(0); k<connectivity.getNumberTargets(42); ++k){
+		EXPECT_EQ (connectivity.getTarget(42, k), same.getTarget(42, k));
+	}
+}
+
+/*
+ * TEST5: Test if the connections drawn by several threads are exactly the ones drawn by one thread,
+ * also for a network whose targets are stored on 32 bits
+*/
+
+TEST (NetworkTest, ParallelConnections){
+	for (int nb_neurons : {1000, 70000}){
+		Connectivity serial(nb_neurons), parallel(nb_neurons);
+		serial.addRandomConnections(nb_neurons*4/5, 20, 5, 9);
+		parallel.addRandomConnections(nb_neurons*4/5, 20, 5, 9, 3);
+		ASSERT_EQ (serial.getNumberConnections(), parallel.getNumberConnections());
+		EXPECT_EQ (size_t(nb_neurons)*25, parallel.getNumberConnections());
+		for (int i(0); i<nb_neurons; ++i){
+			ASSERT_EQ (serial.getNumberTargets(i), parallel.getNumberTargets(i));
+			for (int k(0); k<parallel.getNumberTargets(i); ++k){
+				EXPECT_EQ (serial.getTarget(i, k), parallel.getTarget(i, k));
+				if (k > 0){
+					EXPECT_LE (parallel.getTarget(i, k-1), parallel.getTarget(i, k)); //the targets are sorted
+				}
+			}
+		}
+	}
+}
+
+/*
+ * TEST6: Test if the connections added one by one are sorted by pre-synaptic neuron,
+ * also when the structure is built several times.
+*/
+
+TEST (NetworkTest, BuildConnections){
+	Connectivity connectivity(4);
+	connectivity.addConnection(3, 0);
+	connectivity.addConnection(1, 2);
+	connectivity.build();
+	connectivity.addConnection(1, 3);
+	connectivity.addConnection(3, 1);
+	connectivity.build();
+	EXPECT_EQ (4u, connectivity.getNumberConnections());
+	EXPECT_EQ (0, connectivity.getNumberTargets(0));
+	ASSERT_EQ (2, connectivity.getNumberTargets(1));
+	EXPECT_EQ (2, connectivity.getTarget(1, 0));
+	EXPECT_EQ (3, connectivity.getTarget(1, 1));
+	ASSERT_EQ (2, connectivity.getNumberTargets(3));
+	EXPECT_EQ (0, connectivity.getTarget(3, 0));
+	EXPECT_EQ (1, connectivity.getTarget(3, 1));
+	//4 offsets + 1 and 4 targets on 16 bits
+	EXPECT_EQ (5*sizeof(std::size_t) + 4*sizeof(std::uint16_t), connectivity.getMemory());
+}
+
+/*
+ * TEST7: Test if the simulation gives exactly the same result for any number of threads,
+ * with the same mean membrane potential
+*/
+
+TEST (NetworkTest, Threads){
+	std::vector<Network*> networks;
+	for (int nb_threads(1); nb_threads<=4; ++nb_threads){
+		Network* network(new Network(4000, 1000, 7)); //same seed for the noises
+		network->addConnections(3); //same connections
+		network->setNumberThreads(nb_threads);
+		EXPECT_EQ (nb_threads, network->getNumberThreads());
+		for (int t(0); t<500; ++t){
+			network->update(5, 2);
+		}
+		networks.push_back(network);
+	}
+	unsigned int nb_spikes(0);
+	double sum(0.0);
+	for (int i(0); i<networks[0]->getNumberNeurons(); ++i){
+		nb_spikes += networks[0]->getNumberSpikes(i);
+		sum += networks[0]->getV_membrane(i);
+		for (size_t k(1); k<networks.size(); ++k){
+			EXPECT_EQ (networks[0]->getV_membrane(i), networks[k]->getV_membrane(i));
+			EXPECT_EQ (networks[0]->getNumberSpikes(i), networks[k]->getNumberSpikes(i));
+		}
+	}
+	EXPECT_GT (nb_spikes, 0u); //the noises make the neurons spike
+	//the mean potential is summed by the threads updating the partitions
+	for (size_t k(1); k<networks.size(); ++k){
+		EXPECT_EQ (networks[0]->getMeanV_membrane(), networks[k]->getMeanV_membrane());
+	}
+	EXPECT_NEAR (sum/5000, networks[0]->getMeanV_membrane(), 1e-9);
+	networks[0]->setV_membrane(0, networks[0]->getV_membrane(0) + 5000.0);
+	EXPECT_NEAR (sum/5000 + 1.0, networks[0]->getMeanV_membrane(), 1e-9);
+	for (auto& n : networks){
+		delete n;
+		n = nullptr;
+	}
+}
+
+/*
+ * TEST8: Test if the amplitudes of spikes coming from different partitions are all received by
+ * targets in different partitions, when the partitions are updated in parallel
+*/
+
+TEST (NetworkTest, ParallelDelivery){
+	Network network(500, 100); //the neurons are in three partitions
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(600));
+	const std::vector<int> sources {0, 300, 550}; //one source in each partition, 550 is inhibitory
+	for (auto const& s : sources){
+		connectivity->addConnection(s, 599);
+		connectivity->addConnection(s, 1);
+		connectivity->addConnection(s, 1); //two connections between the same neurons
+		network.setV_membrane(s, 21.0);
+	}
+	connectivity->build();
+	EXPECT_EQ (1, connectivity->getTarget(300, 0)); //the targets have been sorted
+	EXPECT_EQ (599, connectivity->getTarget(300, 2));
+	network.setConnectivity(connectivity);
+	network.setNumberThreads(3);
+	for (int i(0); i<=D; ++i){
+		network.update(5, 0.0);
+	}
+	EXPECT_NEAR (2*(J_e + J_e - 5*J_e), network.getV_membrane(1), 0.001);
+	EXPECT_NEAR (J_e + J_e - 5*J_e, network.getV_membrane(599), 0.001);
+}
+
+/*
+ * TEST9: Test if updating the network during D time steps at once gives exactly the same result
+ * and the same spikes as D updates of one time step
+*/
+
+TEST (NetworkTest, LookaheadWindow){
+	Network step(4000, 1000, 11), window(4000, 1000, 11);
+	step.addConnections(5);
+	window.setConnectivity(step.getConnectivity()); //the connections are shared
+	window.setNumberThreads(2);
+	std::vector<Spike> step_spikes, window_spikes;
+	for (int t(0); t<40; ++t){
+		for (int k(0); k<D; ++k){
+			step.update(5, 2);
+			step.getSpikes(step_spikes);
+		}
+		window.update(5, 2, D);
+		window.getSpikes(window_spikes);
+	}
+	EXPECT_EQ (step.getClock(), window.getClock());
+	for (int i(0); i<step.getNumberNeurons(); ++i){
+		EXPECT_EQ (step.getV_membrane(i), window.getV_membrane(i));
+	}
+	ASSERT_EQ (step_spikes.size(), window_spikes.size());
+	EXPECT_GT (step_spikes.size(), 0u);
+	for (size_t k(0); k<step_spikes.size(); ++k){
+		EXPECT_EQ (step_spikes[k].step, window_spikes[k].step);
+		EXPECT_EQ (step_spikes[k].neuron, window_spikes[k].neuron);
+	}
+}
+
+/*
+ * TEST10: Test if a network restored from a checkpoint continues exactly as the network that was saved
+*/
+
+TEST (NetworkTest, Checkpoint){
+	Network network(800, 200, 21);
+	network.addConnections(22, 80, 20);
+	network.setNumberThreads(2);
+	for (int t(0); t<20; ++t){
+		network.update(5, 2, D); //the boxes of the time buffers contain spikes not yet received
+	}
+	network.saveCheckpoint("test_checkpoint.bin");
+
+	Network restored(800, 200, 99); //other noises and no connections
+	restored.loadCheckpoint("test_checkpoint.bin");
+	EXPECT_EQ (network.getClock(), restored.getClock());
+	EXPECT_EQ (network.getConnectivity()->getNumberConnections(), restored.getConnectivity()->getNumberConnections());
+	for (int t(0); t<20; ++t){
+		network.update(5, 2, D);
+		restored.update(5, 2, D);
+	}
+	for (int i(0); i<1000; ++i){
+		EXPECT_EQ (network.getV_membrane(i), restored.getV_membrane(i));
+		EXPECT_EQ (network.getNumberSpikes(i), restored.getNumberSpikes(i));
+		EXPECT_EQ (network.getRefractoryState(i), restored.getRefractoryState(i));
+	}
+}
+
+/*
+ * TEST11: Test if the vector kernels give exactly the same result as the kernel updating the neurons one by one,
+ * also for a last partition whose size is not a multiple of the vector size
+*/
+
+TEST (NetworkTest, Instructions){
+	Network scalar(803, 200, 31);
+	scalar.addConnections(32, 80, 20);
+	scalar.setInstructions(Instructions::scalar);
+	for (auto instructions : {Instructions::avx2, Instructions::avx512}){
+		if (not isSupported(instructions)){
+			std::cout << getName(instructions) << " is not supported by the processor" << std::endl;
+			continue;
+		}
+		Network vector(803, 200, 31);
+		vector.setConnectivity(scalar.getConnectivity());
+		vector.setInstructions(instructions);
+		Network reference(803, 200, 31);
+		reference.setConnectivity(scalar.getConnectivity());
+		reference.setInstructions(Instructions::scalar);
+		for (int t(0); t<40; ++t){
+			vector.update(5, 2, D);
+			reference.update(5, 2, D);
+		}
+		for (int i(0); i<1003; ++i){
+			EXPECT_EQ (reference.getV_membrane(i), vector.getV_membrane(i));
+			EXPECT_EQ (reference.getNumberSpikes(i), vector.getNumberSpikes(i));
+			EXPECT_EQ (reference.getRefractoryState(i), vector.getRefractoryState(i));
+			EXPECT_EQ (reference.getSpikeState(i), vector.getSpikeState(i));
+		}
+		std::vector<Spike> reference_spikes, vector_spikes;
+		reference.getSpikes(reference_spikes);
+		vector.getSpikes(vector_spikes);
+		ASSERT_EQ (reference_spikes.size(), vector_spikes.size());
+		for (size_t k(0); k<vector_spikes.size(); ++k){
+			EXPECT_EQ (reference_spikes[k].step, vector_spikes[k].step);
+			EXPECT_EQ (reference_spikes[k].neuron, vector_spikes[k].neuron);
+		}
+	}
+}
+
+/*
+ * TEST12: Test if the memory of the neurons is counted: 8 bytes for the membrane potential, 1 for the refractory
+ * counter, 1 for the spike state, 4 for the number of spikes and 4 for each box of the time buffer
+*/
+
+TEST (NetworkTest, Memory){
+	Network network(800, 200);
+	EXPECT_EQ (1000u*(8 + 1 + 1 + 4 + 4*(D+1)), network.getMemory());
+	network.addConnections(1, 80, 20);
+	const std::shared_ptr<const Connectivity> connectivity(network.getConnectivity());
+	//the targets of a small network are stored on 16 bits, with one offset of 64 bits per neuron
+	EXPECT_EQ (connectivity->getNumberConnections()*2 + 1001u*8, connectivity->getMemory());
+}
+
+/*
+ * TEST13: Test if the list of the last spikes contains exactly the neurons whose spike state is set
+*/
+
+TEST (NetworkTest, SpikeList){
+	Network network(800, 200, 5);
+	network.addConnections(2, 80, 20);
+	std::size_t nb_spikes(0);
+	while (network.getClock() < 500){
+		network.update(3, 2); //one time step
+		std::vector<Spike> const& spikes(network.getLastSpikes());
+		std::vector<Spike> copy;
+		network.getSpikes(copy);
+		ASSERT_EQ (copy.size(), spikes.size());
+		size_t k(0);
+		for (int i(0); i<1000; ++i){
+			if (network.getSpikeState(i)){
+				ASSERT_LT (k, spikes.size());
+				EXPECT_EQ (i, spikes[k].neuron);
+				EXPECT_EQ (network.getClock() - N, spikes[k].step);
+				++k;
+			}
+		}
+		EXPECT_EQ (k, spikes.size());
+		nb_spikes += spikes.size();
+	}
+	EXPECT_GT (nb_spikes, 0u);
+}
+
+/*
+ * TEST14: Test if the weights of the connections multiply the amplitudes: weights of 1 give exactly the same
+ * simulation as connections without weights, and the weights are kept in a checkpoint
+*/
+
+TEST (NetworkTest, Weights){
+	Network network(800, 200, 41);
+	network.addConnections(42, 80, 20);
+	std::shared_ptr<Connectivity> weighted(std::make_shared<Connectivity>(*network.getConnectivity()));
+	weighted->addWeights();
+	EXPECT_TRUE (weighted->hasWeights());
+	EXPECT_FALSE (network.getConnectivity()->hasWeights());
+	Network same(800, 200, 41);
+	same.setConnectivity(weighted);
+	for (int t(0); t<20; ++t){
+		network.update(5, 2, D);
+		same.update(5, 2, D);
+	}
+	for (int i(0); i<1000; ++i){
+		EXPECT_EQ (network.getV_membrane(i), same.getV_membrane(i));
+	}
+
+	//the neuron 1 receives one excitatory connection of weight 3 and one inhibitory connection of weight 0.5
+	Network small(2, 1);
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(3));
+	connectivity->addConnection(0, 1);
+	connectivity->addConnection(2, 1);
+	connectivity->build();
+	connectivity->addWeights(2.0f);
+	connectivity->setWeight(0, 0, 3.0f);
+	connectivity->setWeight(2, 0, 0.5f);
+	EXPECT_EQ (3.0f, connectivity->getWeight(0, 0));
+	EXPECT_EQ (4*sizeof(std::size_t) + 2*sizeof(std::uint16_t) + 2*sizeof(float), connectivity->getMemory()); //4 offsets, 2 targets, 2 weights
+	small.setConnectivity(connectivity);
+	small.setV_membrane(0, 21.0);
+	small.setV_membrane(2, 21.0);
+	small.saveCheckpoint("test_weights.bin");
+	Network restored(2, 1);
+	restored.loadCheckpoint("test_weights.bin");
+	EXPECT_TRUE (restored.getConnectivity()->hasWeights());
+	EXPECT_EQ (0.5f, restored.getConnectivity()->getWeight(2, 0));
+	for (int i(0); i<=D; ++i){
+		small.update(5, 0.0);
+		restored.update(5, 0.0);
+	}
+	EXPECT_NEAR (3*J_e - 0.5*5*J_e, small.getV_membrane(1), 0.001);
+	EXPECT_EQ (small.getV_membrane(1), restored.getV_membrane(1));
+}
+
+/*
+ * TEST15: Test the delays of the connections: each spike is received after the delay of its connection,
+ * the window is limited by the shortest delay, the amplitudes already received are kept when the time buffers
+ * get more boxes and the delays are kept in a checkpoint
+*/
+
+TEST (NetworkTest, Delays){
+	//delays of D give exactly the same simulation as connections without delays
+	Network network(800, 200, 51);
+	network.addConnections(52, 80, 20);
+	std::shared_ptr<Connectivity> delayed(std::make_shared<Connectivity>(*network.getConnectivity()));
+	delayed->addDelays();
+	EXPECT_TRUE (delayed->hasDelays());
+	Network same(800, 200, 51);
+	same.setConnectivity(delayed);
+	EXPECT_EQ (D, same.getMinDelay());
+	for (int t(0); t<20; ++t){
+		network.update(5, 2, D);
+		same.update(5, 2, D);
+	}
+	for (int i(0); i<1000; ++i){
+		EXPECT_EQ (network.getV_membrane(i), same.getV_membrane(i));
+	}
+
+	//the neuron 0 spikes at the first step and is connected to the neuron 1 with a delay of 30
+	//and to the neuron 2 with a delay of 4
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(3));
+	connectivity->addConnection(0, 1);
+	connectivity->addConnection(0, 2);
+	connectivity->build();
+	connectivity->addDelays(30);
+	connectivity->setDelay(0, 1, 4);
+	EXPECT_EQ (4, connectivity->getMinDelay());
+	EXPECT_EQ (30, connectivity->getMaxDelay());
+	EXPECT_EQ (4*sizeof(std::size_t) + 2*sizeof(std::uint16_t) + 2*sizeof(std::uint8_t), connectivity->getMemory());
+	Network small(2, 1);
+	small.setConnectivity(connectivity);
+	EXPECT_EQ (4, small.getMinDelay());
+	EXPECT_EQ (30, small.getMaxDelay());
+	small.setV_membrane(0, 21.0);
+	for (int i(0); i<4; ++i){
+		small.update(5, 0.0);
+	}
+	EXPECT_EQ (0.0, small.getV_membrane(2));
+	small.update(5, 0.0);
+	EXPECT_NEAR (J_e, small.getV_membrane(2), 0.001);
+	small.saveCheckpoint("test_delays.bin");
+	Network restored(2, 1);
+	restored.loadCheckpoint("test_delays.bin");
+	EXPECT_EQ (30, restored.getConnectivity()->getDelay(0, 0));
+	EXPECT_EQ (4, restored.getMinDelay());
+	EXPECT_EQ (30, restored.getMaxDelay());
+	//the windows of the shortest delay give the same result as the steps one by one
+	for (int t(0); t<6; ++t){
+		small.update(5, 0.0, 4);
+		restored.update(5, 0.0, 4);
+	}
+	EXPECT_EQ (0.0, small.getV_membrane(1));
+	small.update(5, 0.0, 2);
+	restored.update(5, 0.0);
+	restored.update(5, 0.0);
+	EXPECT_NEAR (J_e, small.getV_membrane(1), 0.001);
+	EXPECT_EQ (small.getV_membrane(1), restored.getV_membrane(1));
+	EXPECT_EQ (small.getV_membrane(2), restored.getV_membrane(2));
+
+	//a spike sent with the delay D is still received when the time buffers get more boxes
+	Network growing(2, 1);
+	std::shared_ptr<Connectivity> direct(std::make_shared<Connectivity>(3));
+	direct->addConnection(0, 1);
+	direct->build();
+	growing.setConnectivity(direct);
+	growing.setV_membrane(0, 21.0);
+	for (int i(0); i<5; ++i){
+		growing.update(5, 0.0);
+	}
+	growing.setConnectivity(connectivity);
+	EXPECT_EQ (30, growing.getMaxDelay());
+	for (int i(5); i<=D; ++i){
+		growing.update(5, 0.0);
+	}
+	EXPECT_NEAR (J_e, growing.getV_membrane(1), 0.001);
+}
@@ -16,7 +16,9 @@ Neuron::Neuron (bool excitatory_neuron,
   t_spike_(t_spike), spike_(spike), 
   neuron_clock_ (neuron_clock), 
   external_input_(external_input),
-  r_period_(r_period)
+  r_period_(r_period),
+  nb_excitatory_connections_(0),
+  nb_inhibitory_connections_(0)
 {
 	//each box of the buffer is setted to zero at the beginning
 	for (size_t i(0); i<t_buffer_.size(); ++i){ 
@@ -214,11 +216,10 @@ void Neuron::solveMembraneEquation(double input, double ampl, double noise)
 	V_membrane_ = const1*V_membrane_ + const2*input + ampl + noise;
 }
 
-void Neuron::addConnections(std::array<Neuron*, total_neurons>  const& neurons)
+void Neuron::addConnections(std::array<Neuron*, total_neurons>  const& neurons, unsigned int seed)
 {
-	//algorithmes for generating random numbers
-	std::random_device rd; 
-	std::mt19937 gen(rd()); 
+	//algorithme for generating random numbers, the same seed gives the same connections
+	std::mt19937 gen(seed); 
 	
 	//distribution of random integer numbers to determine which excitatory
 	//or inhibitory neuron is connected to the current neuron. 
@@ -0,0 +1,247 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include "Neuron.hpp"
+#include "Network.hpp"
+#include "EventNetwork.hpp"
+#include "benchmark/benchmark.h"
+
+/*
+ * Benchmarks of the paths executed at each time step of a simulation and of the construction of the networks.
+ * The items per second are the operations named in each benchmark (updates, deliveries, connections, draws
+ * or time steps). The results are written in NeuronProject_bench.json, unless another --benchmark_out is given.
+*/
+
+//the pairs (g, nu_ext/nu_thr) of the graphs A, B, C and D of the Brunel's network
+static const double regimes[4][2] = {{3.0, 2.0}, {6.0, 4.0}, {5.0, 2.0}, {4.5, 0.9}};
+
+//Run all the benchmarks, the results are also written in a JSON file
+
+int main(int argc, char** argv){
+	std::vector<char*> arguments(argv, argv + argc);
+	bool output(false);
+	for (int k(1); k<argc; ++k){
+		output = output or std::strncmp(argv[k], "--benchmark_out=", 16) == 0;
+	}
+	std::string out ("--benchmark_out=NeuronProject_bench.json"), format ("--benchmark_out_format=json");
+	if (not output){
+		arguments.insert(arguments.begin() + 1, &out[0]);
+		arguments.insert(arguments.begin() + 2, &format[0]);
+	}
+	int nb_arguments(arguments.size());
+	::benchmark::Initialize(&nb_arguments, arguments.data());
+	if (::benchmark::ReportUnrecognizedArguments(nb_arguments, arguments.data())){
+		return 1;
+	}
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+	return 0;
+}
+
+/*
+ * BENCH1: Update of one Neuron without spike, with the noise already drawn
+*/
+
+static void NeuronUpdate(benchmark::State& state){
+	Neuron neuron(true);
+	neuron.setExternalInput(0.5); //stays below the threshold
+	for (auto _ : state){
+		neuron.update(1, 0.1, 5);
+		benchmark::DoNotOptimize(neuron.getV_membrane());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(NeuronUpdate);
+
+/*
+ * BENCH2: Delivery of one spike of a Neuron to its targets, the argument is the number of targets
+*/
+
+static void NeuronUpdateTargets(benchmark::State& state){
+	Neuron neuron(false);
+	std::vector<Neuron> targets(state.range(0), Neuron(true));
+	for (auto& target : targets){
+		neuron.addTargetNeuron(&target);
+	}
+	for (auto _ : state){
+		neuron.updateTargets(5);
+	}
+	benchmark::DoNotOptimize(targets[0].getTimeBuffer(D));
+	state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(NeuronUpdateTargets)->Arg(100)->Arg(1250);
+
+/*
+ * BENCH3: Delivery of the spikes of 1000 neurons, each one to 1250 random targets among the neurons of a network
+ * stored in one array, the arguments are the number of neurons and 1 if the targets are sorted by index,
+ * the order of the targets in a Connectivity
+*/
+
+static void NeuronScatter(benchmark::State& state){
+	std::vector<Neuron> neurons(state.range(0), Neuron(true));
+	const int nb_sources(1000);
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<> dis(0, state.range(0)-1);
+	std::vector<int> targets(c_e + c_i);
+	for (int i(0); i<nb_sources; ++i){
+		for (auto& target : targets){
+			target = dis(gen);
+		}
+		if (state.range(1)){
+			std::sort(targets.begin(), targets.end());
+		}
+		for (auto const& target : targets){
+			neurons[i].addTargetNeuron(&neurons[target]);
+		}
+	}
+	int source(0);
+	for (auto _ : state){
+		neurons[source].updateTargets(5);
+		source = (source + 1)%nb_sources;
+	}
+	benchmark::DoNotOptimize(neurons[1].getTimeBuffer(D));
+	state.SetItemsProcessed(state.iterations()*(c_e + c_i));
+	state.SetLabel(state.range(1) ? "sorted" : "random");
+}
+BENCHMARK(NeuronScatter)->ArgsProduct({{12500, 125000}, {0, 1}});
+
+/*
+ * BENCH4: Random connections of Neuron::addConnections, the argument is the number of neurons connected
+*/
+
+static void NeuronAddConnections(benchmark::State& state){
+	for (auto _ : state){
+		state.PauseTiming();
+		std::vector<Neuron> neurons(total_neurons, Neuron(true));
+		std::array<Neuron*, total_neurons> pointers;
+		for (int i(0); i<total_neurons; ++i){
+			pointers[i] = &neurons[i];
+		}
+		state.ResumeTiming();
+		for (int i(0); i<state.range(0); ++i){
+			neurons[i].addConnections(pointers, i);
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*state.range(0)*(c_e + c_i));
+}
+BENCHMARK(NeuronAddConnections)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/*
+ * BENCH5: Number of external spikes drawn by Neuron::randomSpikes
+*/
+
+static void NeuronRandomSpikes(benchmark::State& state){
+	Neuron neuron(true);
+	for (auto _ : state){
+		benchmark::DoNotOptimize(neuron.randomSpikes(poisson_gen));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(NeuronRandomSpikes);
+
+/*
+ * BENCH6: Number of external spikes drawn by the PoissonGenerator for one partition, the argument is the mean
+*/
+
+static void PoissonGeneratorDraws(benchmark::State& state){
+	PoissonGenerator generator(state.range(0)/10.0, 1);
+	unsigned int counts[partition_size];
+	unsigned int step(0);
+	for (auto _ : state){
+		generator.generate(step++, 0, partition_size, counts);
+		benchmark::DoNotOptimize(counts);
+	}
+	state.SetItemsProcessed(state.iterations()*partition_size);
+}
+BENCHMARK(PoissonGeneratorDraws)->Arg(9)->Arg(20)->Arg(40);
+
+/*
+ * BENCH7: Update of one partition by a membrane kernel, the argument is the instructions (scalar, AVX2, AVX-512)
+*/
+
+static void MembraneKernelUpdate(benchmark::State& state){
+	const Instructions instructions(static_cast<Instructions>(state.range(0)));
+	if (not isSupported(instructions)){
+		state.SkipWithError("the instructions are not supported by the processor");
+		return;
+	}
+	std::vector<double> V(partition_size, 10.0), noise(partition_size, 0.1);
+	std::vector<float> box(partition_size, 0.0f);
+	std::vector<std::uint8_t> refractory(partition_size, 0);
+	std::vector<char> spike(partition_size, 0);
+	std::vector<unsigned int> nb_spikes(partition_size, 0);
+	int spiking[partition_size];
+	MembraneBlock block {V.data(), refractory.data(), spike.data(), nb_spikes.data(), box.data(), noise.data(),
+						 partition_size, 0.0};
+	const MembraneKernel kernel(getMembraneKernel(instructions));
+	for (auto _ : state){
+		benchmark::DoNotOptimize(kernel(block, spiking));
+	}
+	state.SetItemsProcessed(state.iterations()*partition_size);
+	state.SetLabel(getName(instructions));
+}
+BENCHMARK(MembraneKernelUpdate)->DenseRange(0, 2);
+
+/*
+ * BENCH8: Random connections of a Network, the argument is the number of neurons (10 percents of connections)
+*/
+
+static void NetworkAddConnections(benchmark::State& state){
+	const int nb_neurons(state.range(0));
+	for (auto _ : state){
+		Network network(nb_neurons*4/5, nb_neurons/5);
+		network.addConnections(1, nb_neurons*4/50, nb_neurons/50);
+		benchmark::DoNotOptimize(network.getConnectivity()->getNumberConnections());
+	}
+	state.SetItemsProcessed(state.iterations()*std::int64_t(nb_neurons)*(nb_neurons/10));
+}
+BENCHMARK(NetworkAddConnections)->Arg(1250)->Arg(12500)->Unit(benchmark::kMillisecond);
+
+/*
+ * BENCH9: Simulation of a Network by windows of D time steps after 100 milliseconds,
+ * the arguments are the number of neurons and the regime (A, B, C or D)
+*/
+
+static void NetworkSteps(benchmark::State& state){
+	const int nb_neurons(state.range(0));
+	const double g(regimes[state.range(1)][0]), rate(regimes[state.range(1)][1]);
+	Network network(nb_neurons*4/5, nb_neurons/5, 2);
+	network.addConnections(1, nb_neurons*4/50, nb_neurons/50);
+	//the activity of the network reaches its regime before the measure
+	while (network.getClock() < 1000){
+		network.update(g, rate, D);
+	}
+	for (auto _ : state){
+		network.update(g, rate, D);
+	}
+	state.SetItemsProcessed(state.iterations()*D);
+	state.counters["neuron_updates"] = benchmark::Counter(double(state.iterations())*D*nb_neurons, benchmark::Counter::kIsRate);
+	state.SetLabel(std::string(1, char('A' + state.range(1))));
+}
+BENCHMARK(NetworkSteps)->ArgsProduct({{1250, 12500}, {0, 1, 2, 3}})->Unit(benchmark::kMillisecond);
+
+/*
+ * BENCH10: Simulation of an EventNetwork by windows of D time steps after 100 milliseconds,
+ * the arguments are the number of neurons and the regime (A, B, C or D)
+*/
+
+static void EventNetworkSteps(benchmark::State& state){
+	const int nb_neurons(state.range(0));
+	const double g(regimes[state.range(1)][0]), rate(regimes[state.range(1)][1]);
+	EventNetwork network(nb_neurons*4/5, nb_neurons/5, 2);
+	network.addConnections(1, nb_neurons*4/50, nb_neurons/50);
+	while (network.getClock() < 1000){
+		network.update(g, rate, D);
+	}
+	for (auto _ : state){
+		network.update(g, rate, D);
+	}
+	state.SetItemsProcessed(state.iterations()*D);
+	state.counters["neuron_updates"] = benchmark::Counter(double(state.iterations())*D*nb_neurons, benchmark::Counter::kIsRate);
+	state.SetLabel(std::string(1, char('A' + state.range(1))));
+}
+BENCHMARK(EventNetworkSteps)->ArgsProduct({{12500}, {0, 3}})->Unit(benchmark::kMillisecond);
@@ -127,8 +127,8 @@ TEST (NeuronTest, Connections){
 	EXPECT_EQ (12500*1250, j);
 		
 	for (auto& n:neurons){ //clear the memory
-		n = nullptr;
 		delete n;
+		n = nullptr;
 	}
 }
 
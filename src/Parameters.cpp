@@ -0,0 +1,343 @@
+#include "Parameters.hpp"
+#include "Connectivity.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <random>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+
+/*!
+ * @brief Read a number in a string
+ * @details An exception std::invalid_argument is thrown if the string isn't a number.
+ *
+ * @param name : a string indicating the name of the parameter, for the error message
+ * @param value : a string containing the number
+ * @return A double: the number
+ */
+static double toNumber(std::string const& name, std::string const& value)
+{
+	std::istringstream stream (value);
+	double number(0.0);
+	if (not (stream >> number) or not (stream >> std::ws).eof()){
+		throw std::invalid_argument("the value of " + name + " is not a number: " + value);
+	}
+	return number;
+}
+
+/*!
+ * @brief Read a positive integer in a string
+ *
+ * @param name : a string indicating the name of the parameter, for the error message
+ * @param value : a string containing the number
+ * @return An integer: the number
+ */
+static int toInteger(std::string const& name, std::string const& value)
+{
+	const double number(toNumber(name, value));
+	if (number < 0 or number != std::floor(number) or number > std::numeric_limits<int>::max()){
+		throw std::invalid_argument("the value of " + name + " is not a positive integer: " + value);
+	}
+	return number;
+}
+
+/*!
+ * @brief Read a positive integer on 32 bits in a string, for the seeds
+ *
+ * @param name : a string indicating the name of the parameter, for the error message
+ * @param value : a string containing the number
+ * @return An unsigned integer: the number
+ */
+static unsigned int toUnsigned(std::string const& name, std::string const& value)
+{
+	const double number(toNumber(name, value));
+	if (number < 0 or number != std::floor(number) or number > std::numeric_limits<unsigned int>::max()){
+		throw std::invalid_argument("the value of " + name + " is not a positive integer on 32 bits: " + value);
+	}
+	return number;
+}
+
+/*!
+ * @brief Read a list of values (a,b,c) or a range (start:stop:step) in a string
+ *
+ * @param name : a string indicating the name of the parameter, for the error message
+ * @param value : a string containing the values
+ * @return A vector: the values
+ */
+static std::vector<double> toValues(std::string const& name, std::string const& value)
+{
+	std::vector<double> values;
+	if (value.find(':') != std::string::npos){
+		std::vector<double> range;
+		std::istringstream stream (value);
+		std::string number;
+		while (std::getline(stream, number, ':')){
+			range.push_back(toNumber(name, number));
+		}
+		if (range.size() != 3 or range[2] <= 0.0 or range[1] < range[0]){
+			throw std::invalid_argument("the range of " + name + " must be start:stop:step: " + value);
+		}
+		//the stop value is included, the small margin avoids to lose it because of the rounding
+		for (int k(0); range[0] + k*range[2] <= range[1] + 1e-9*range[2]; ++k){
+			values.push_back(range[0] + k*range[2]);
+		}
+	} else {
+		std::istringstream stream (value);
+		std::string number;
+		while (std::getline(stream, number, ',')){
+			values.push_back(toNumber(name, number));
+		}
+	}
+	if (values.empty()){
+		throw std::invalid_argument("no value for " + name);
+	}
+	return values;
+}
+
+
+Parameters::Parameters()
+: mode("network"),
+  engine("step"),
+  nb_excitatory(excitatory_neurons),
+  nb_inhibitory(inhibitory_neurons),
+  conn_e(c_e),
+  conn_i(c_i),
+  J(J_e),
+  g(1, 5.0),
+  rate(1, 2.0),
+  duration(t_stop*h),
+  delay_min(D*h),
+  delay_max(D*h),
+  window(D),
+  threads(std::max(1u, std::thread::hardware_concurrency())),
+  transport("none"),
+  ranks(1),
+  seed(std::random_device()()),
+  noise_seed(std::random_device()()),
+  external_input(std::numeric_limits<double>::quiet_NaN()),
+  output("Spike_time"),
+  record(true),
+  monitor(0.0),
+  checkpoint_interval(0.0)
+{}
+
+void Parameters::readArguments(int argc, char** argv)
+{
+	for (int k(1); k<argc; ++k){
+		std::string argument (argv[k]);
+		if (argument.compare(0, 2, "--") != 0 or argument.size() == 2){
+			throw std::invalid_argument("the parameters must start with --: " + argument);
+		}
+		argument = argument.substr(2);
+		std::string value;
+		const size_t equal(argument.find('='));
+		if (equal != std::string::npos){
+			value = argument.substr(equal+1);
+			argument = argument.substr(0, equal);
+		} else if (k+1 < argc){
+			value = argv[++k];
+		} else {
+			throw std::invalid_argument("no value for " + argument);
+		}
+		if (argument == "config"){
+			readFile(value);
+		} else {
+			set(argument, value);
+		}
+	}
+}
+
+void Parameters::readFile(std::string const& file_name)
+{
+	std::ifstream file (file_name.c_str());
+	if (file.fail()){
+		throw std::invalid_argument("the configuration file can't be read: " + file_name);
+	}
+	std::string line;
+	while (std::getline(file, line)){
+		//the spaces and the comments are ignored
+		line = line.substr(0, line.find('#'));
+		line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+		if (line.empty()){
+			continue;
+		}
+		const size_t equal(line.find('='));
+		if (equal == std::string::npos){
+			throw std::invalid_argument("the lines of " + file_name + " must be name = value: " + line);
+		}
+		set(line.substr(0, equal), line.substr(equal+1));
+	}
+}
+
+void Parameters::set(std::string const& name, std::string const& value)
+{
+	if (name == "mode"){
+		if (value != "network" and value != "one" and value != "two" and value != "A" and value != "B"
+			and value != "C" and value != "D"){
+			throw std::invalid_argument("unknown mode: " + value);
+		}
+		mode = value;
+	} else if (name == "engine"){
+		if (value != "step" and value != "event"){
+			throw std::invalid_argument("unknown engine: " + value);
+		}
+		engine = value;
+	} else if (name == "excitatory" or name == "inhibitory"){
+		//the connections are drawn from both populations, neither can be empty
+		const int size(toInteger(name, value));
+		if (size < 1){
+			throw std::invalid_argument("the number of " + name + " neurons must be at least 1: " + value);
+		}
+		(name == "excitatory" ? nb_excitatory : nb_inhibitory) = size;
+	} else if (name == "ce" or name == "ci"){
+		const int nb_connections(toInteger(name, value));
+		if (nb_connections < 1){
+			throw std::invalid_argument("the number of connections " + name + " must be at least 1: " + value);
+		}
+		(name == "ce" ? conn_e : conn_i) = nb_connections;
+	} else if (name == "J"){
+		J = toNumber(name, value);
+		//the rate nu_ext/nu_thr is divided by J
+		if (not (J > 0.0)){
+			throw std::invalid_argument("the amplitude J must be strictly positive: " + value);
+		}
+	} else if (name == "g"){
+		g = toValues(name, value);
+	} else if (name == "rate"){
+		rate = toValues(name, value);
+		for (auto const& r : rate){
+			if (r < 0.0){
+				throw std::invalid_argument("the rate must be positive: " + value);
+			}
+		}
+	} else if (name == "duration"){
+		duration = toNumber(name, value);
+		if (not (std::round(duration/h) >= 1)){
+			throw std::invalid_argument("the duration must be at least one time step: " + value);
+		}
+	} else if (name == "delay"){
+		const size_t colon(value.find(':'));
+		const double shortest(toNumber(name, value.substr(0, colon)));
+		const double longest(colon == std::string::npos ? shortest : toNumber(name, value.substr(colon+1)));
+		//the delays are stored in time steps on 8 bits
+		if (std::round(shortest/h) < 1 or std::round(longest/h) > max_delay or longest < shortest){
+			throw std::invalid_argument("the delay must be one value or a range min:max between h and 255*h: " + value);
+		}
+		delay_min = shortest;
+		delay_max = longest;
+	} else if (name == "window"){
+		window = toInteger(name, value);
+		if (window < 1 or window > max_delay){
+			throw std::invalid_argument("the window must be between 1 and 255: " + value);
+		}
+	} else if (name == "threads"){
+		threads = toInteger(name, value);
+		if (threads < 1){
+			throw std::invalid_argument("the number of threads must be at least 1: " + value);
+		}
+	} else if (name == "transport"){
+		if (value != "none" and value != "local" and value != "mpi"){
+			throw std::invalid_argument("unknown transport: " + value);
+		}
+		transport = value;
+	} else if (name == "ranks"){
+		ranks = toInteger(name, value);
+		if (ranks < 1){
+			throw std::invalid_argument("the number of ranks must be at least 1: " + value);
+		}
+	} else if (name == "seed"){
+		seed = toUnsigned(name, value);
+	} else if (name == "noise_seed"){
+		noise_seed = toUnsigned(name, value);
+	} else if (name == "input"){
+		external_input = toNumber(name, value);
+	} else if (name == "output"){
+		output = value;
+	} else if (name == "record"){
+		if (value != "0" and value != "1"){
+			throw std::invalid_argument("the value of record must be 0 or 1: " + value);
+		}
+		record = (value == "1");
+	} else if (name == "monitor"){
+		monitor = toNumber(name, value);
+		if (monitor < 0.0){
+			throw std::invalid_argument("the width of the bins of the monitor must be positive: " + value);
+		}
+	} else if (name == "checkpoint"){
+		checkpoint = value;
+	} else if (name == "checkpoint_interval"){
+		checkpoint_interval = toNumber(name, value);
+		if (checkpoint_interval < 0.0){
+			throw std::invalid_argument("the checkpoint interval must be positive: " + value);
+		}
+	} else if (name == "restart"){
+		restart = value;
+	} else {
+		throw std::invalid_argument("unknown parameter: " + name);
+	}
+}
+
+int Parameters::getNumberNeurons() const
+{
+	return nb_excitatory + nb_inhibitory;
+}
+
+int Parameters::getNumberSteps() const
+{
+	return std::round(duration/h);
+}
+
+bool Parameters::isSweep() const
+{
+	return g.size()*rate.size() > 1;
+}
+
+int Parameters::getMinDelay() const
+{
+	return std::round(delay_min/h);
+}
+
+int Parameters::getMaxDelay() const
+{
+	return std::round(delay_max/h);
+}
+
+double Parameters::getPoissonMean(double rate) const
+{
+	//tau is in time steps, the time step cancels out
+	return rate*V_thr/(J*tau);
+}
+
+std::string Parameters::getUsage()
+{
+	return "usage: NeuronProject [--name value]...\n"
+		   "  --config file      read the parameters of a file (one name = value per line)\n"
+		   "  --mode m           network (default), one, two, A, B, C or D (graphs of the Brunel's network)\n"
+		   "  --engine e         step (default) or event: only the neurons receiving spikes are updated\n"
+		   "  --excitatory n     number of excitatory neurons (10000)\n"
+		   "  --inhibitory n     number of inhibitory neurons (2500)\n"
+		   "  --ce n             connections received from excitatory neurons (1000)\n"
+		   "  --ci n             connections received from inhibitory neurons (250)\n"
+		   "  --J v              amplitude of an excitatory spike in mV (0.1)\n"
+		   "  --g values         rate J_i/J_e: one value, a list a,b,c or a range start:stop:step (5)\n"
+		   "  --rate values      rate nu_ext/nu_thr: one value, a list or a range (2)\n"
+		   "  --duration ms      duration of the simulation (1200)\n"
+		   "  --delay ms         delay of the connections: one value or a range min:max (1.5)\n"
+		   "  --window n         time steps between two exchanges of spikes, at most the shortest delay (15)\n"
+		   "  --threads n        number of threads (all the cores)\n"
+		   "  --transport t      none (default), local (ranks in this process) or mpi (ranks started by mpirun)\n"
+		   "  --ranks n          number of ranks of the local transport (1)\n"
+		   "  --seed n           seed of the connections (random)\n"
+		   "  --noise_seed n     seed of the noises (random)\n"
+		   "  --input v          external input of the one and two neurons simulations (asked)\n"
+		   "  --output name      name of the spike file without .bin (Spike_time)\n"
+		   "  --record 0|1       write the spikes in the spike file (1)\n"
+		   "  --monitor ms       width of the bins of the rates written in output_population.csv (0: none)\n"
+		   "  --checkpoint file  save the state of the network in a checkpoint file at the end (none)\n"
+		   "  --checkpoint_interval ms\n"
+		   "                     also save it at this interval of simulation (0: only at the end)\n"
+		   "  --restart file     continue the simulation from a checkpoint file (none)\n";
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include "Parameters.hpp"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the default parameters are the ones of the Brunel's network
+*/
+
+TEST (ParametersTest, Default){
+	Parameters parameters;
+	EXPECT_EQ ("network", parameters.mode);
+	EXPECT_EQ ("step", parameters.engine);
+	EXPECT_EQ (total_neurons, parameters.getNumberNeurons());
+	EXPECT_EQ (c_e, parameters.conn_e);
+	EXPECT_EQ (c_i, parameters.conn_i);
+	EXPECT_EQ (J_e, parameters.J);
+	EXPECT_EQ (t_stop, parameters.getNumberSteps());
+	EXPECT_EQ (D, parameters.window);
+	EXPECT_EQ (D, parameters.getMinDelay());
+	EXPECT_EQ (D, parameters.getMaxDelay());
+	EXPECT_TRUE (parameters.record);
+	EXPECT_EQ (0.0, parameters.monitor);
+	EXPECT_FALSE (parameters.isSweep());
+	//with J = 0.1 mV the mean of the noises is the rate nu_ext/nu_thr, it's inversely proportional to J
+	EXPECT_NEAR (2.0, parameters.getPoissonMean(2.0), 1e-12);
+	parameters.J = 0.2;
+	EXPECT_NEAR (1.0, parameters.getPoissonMean(2.0), 1e-12);
+}
+
+/*
+ * TEST2: Test the parameters of the command line, with lists and ranges of values
+*/
+
+TEST (ParametersTest, Arguments){
+	Parameters parameters;
+	const char* argv[] = {"NeuronProject", "--excitatory", "800", "--inhibitory=200", "--ce", "80",
+						  "--g", "3,4.5,6", "--rate=1:2:0.5", "--duration", "100", "--seed", "7", "--delay", "0.5:2"};
+	parameters.readArguments(15, const_cast<char**>(argv));
+	EXPECT_EQ (1000, parameters.getNumberNeurons());
+	EXPECT_EQ (80, parameters.conn_e);
+	EXPECT_EQ (1000, parameters.getNumberSteps());
+	EXPECT_EQ (7u, parameters.seed);
+	parameters.set("noise_seed", "4294967295"); //the seeds are unsigned integers on 32 bits
+	EXPECT_EQ (4294967295u, parameters.noise_seed);
+	EXPECT_EQ (5, parameters.getMinDelay());
+	EXPECT_EQ (20, parameters.getMaxDelay());
+	ASSERT_EQ (3u, parameters.g.size());
+	EXPECT_EQ (4.5, parameters.g[1]);
+	ASSERT_EQ (3u, parameters.rate.size()); //the end of the range is included
+	EXPECT_EQ (1.0, parameters.rate[0]);
+	EXPECT_EQ (2.0, parameters.rate[2]);
+	EXPECT_TRUE (parameters.isSweep());
+}
+
+/*
+ * TEST3: Test the configuration file, the comments and the parameters given after it
+*/
+
+TEST (ParametersTest, ConfigurationFile){
+	{
+		std::ofstream file ("test_parameters.cfg");
+		file << "# small network\n"
+			 << "excitatory = 400\n"
+			 << "inhibitory = 100 # 20 percents\n"
+			 << "\n"
+			 << "g = 4\n"
+			 << "window = 5\n"
+			 << "record = 0\n"
+			 << "monitor = 2.5\n";
+	}
+	Parameters parameters;
+	const char* argv[] = {"NeuronProject", "--config", "test_parameters.cfg", "--g", "6"};
+	parameters.readArguments(5, const_cast<char**>(argv));
+	EXPECT_EQ (500, parameters.getNumberNeurons());
+	EXPECT_EQ (5, parameters.window);
+	EXPECT_FALSE (parameters.record);
+	EXPECT_EQ (2.5, parameters.monitor);
+	ASSERT_EQ (1u, parameters.g.size());
+	EXPECT_EQ (6.0, parameters.g[0]);
+}
+
+/*
+ * TEST4: Test if the wrong parameters are refused
+*/
+
+TEST (ParametersTest, Errors){
+	Parameters parameters;
+	EXPECT_THROW (parameters.set("size", "10"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("ce", "ten"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("ce", "-3"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("ce", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("ci", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("J", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("J", "-0.1"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("duration", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("duration", "-100"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("threads", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("threads", "-2"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("seed", "-1"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("noise_seed", "4294967296"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("inhibitory", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("excitatory", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("window", "256"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("delay", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("delay", "3:1"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("delay", "1:30"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("record", "yes"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("monitor", "-1"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("g", "6:3:1"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("mode", "E"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("engine", "exact"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("transport", "tcp"), std::invalid_argument);
+	EXPECT_THROW (parameters.set("ranks", "0"), std::invalid_argument);
+	EXPECT_THROW (parameters.readFile("no_file.cfg"), std::invalid_argument);
+	const char* argv[] = {"NeuronProject", "--g"};
+	EXPECT_THROW (parameters.readArguments(2, const_cast<char**>(argv)), std::invalid_argument);
+}
+
+/*
+ * TEST5: Test if every parameter is described in the usage
+*/
+
+TEST (ParametersTest, Usage){
+	const std::string usage(Parameters::getUsage());
+	for (std::string name : {"config", "mode", "engine", "excitatory", "inhibitory", "ce", "ci", "J", "g", "rate",
+							 "duration", "delay", "window", "threads", "transport", "ranks", "seed", "noise_seed",
+							 "input", "output", "record", "monitor", "checkpoint", "checkpoint_interval", "restart"}){
+		EXPECT_NE (std::string::npos, usage.find("--" + name + " ")) << name;
+	}
+}
@@ -0,0 +1,134 @@
+#include "Partition.hpp"
+#include <algorithm>
+
+
+/*!
+ * @brief Update the neurons of one partition during several time steps
+ * @details Without noise the loop doesn't have to draw random numbers, it's chosen at compilation.
+ */
+template <bool Noise>
+static void updateSteps(MembraneKernel kernel, MembraneBlock block, float* t_buffer, const std::size_t* rows,
+						int nb_boxes, const PoissonGenerator* noise, double amplitude, int first, unsigned int clock,
+						int nb_steps, std::vector<Spike>& spikes)
+{
+	double noises[partition_size] = {0.0};
+	unsigned int counts[partition_size];
+	block.noise = noises;
+	int spiking[partition_size];
+
+	for (unsigned int step(clock); step<clock + nb_steps*N; step += N){
+		//the box read in this step
+		block.box = t_buffer + rows[step%nb_boxes];
+		//the noise is drawn for every neuron, as in the simulation with the objects Neuron,
+		//all the neurons of the partition at once
+		if (Noise){
+			noise->generate(step, first, block.size, counts);
+			for (int k(0); k<block.size; ++k){
+				noises[k] = amplitude*counts[k];
+			}
+		}
+		//the neurons are updated by the vector kernel, which gives the list of the spiking neurons
+		const int nb_spiking(kernel(block, spiking));
+		for (int k(0); k<nb_spiking; ++k){
+			spikes.push_back({step, first + spiking[k]});
+		}
+	}
+}
+
+/*!
+ * @brief Add the amplitude of a spike to its targets in one partition
+ * @details The template parameters choose at compilation if the amplitude is multiplied by the weight
+ * of each connection and if each connection has its own delay, so the loop without weights and delays
+ * is the same as a loop adding the amplitude in one box.
+ *
+ * @param t_buffer : the time buffers of all the neurons
+ * @param rows : the first value of the box of each delay for the time step of the spike
+ * @param targets : the targets of the connections
+ * @param weights : the weights of the connections, used when Weighted is true
+ * @param delays : the delays of the connections, used when Delayed is true
+ * @param k : an integer indicating the position of the first target in the partition
+ * @param last : an integer indicating the position after the last target of the spiking neuron
+ * @param end : an integer indicating the neuron after the partition
+ * @param ampl : a double indicating the amplitude of the spike
+ * @return An integer: the position of the first target after the partition
+ */
+template <bool Weighted, bool Delayed, typename Index>
+static std::size_t scatter(float* t_buffer, const std::size_t* rows, const Index* targets, const float* weights,
+						   const std::uint8_t* delays, std::size_t k, std::size_t last, int end, double ampl)
+{
+	for (; k < last and int(targets[k]) < end; ++k){
+		t_buffer[rows[Delayed ? delays[k] : D] + targets[k]] += Weighted ? ampl*weights[k] : ampl;
+	}
+	return k;
+}
+
+/*!
+ * @brief Send the amplitudes of spikes to several partitions, with targets of one width
+ */
+template <typename Index>
+static std::uint64_t sendSpikes(Connectivity const& connectivity, const Index* targets, std::vector<Spike> const& spikes,
+								float* t_buffer, const std::size_t* rows, int nb_boxes, int nb_neurons, int nb_excitatory,
+								int first, int last, std::vector<std::size_t>& positions, double ampl_e, double ampl_i)
+{
+	const std::size_t* offsets(connectivity.getOffsets());
+	const float* weights(connectivity.getWeights());
+	const std::uint8_t* delays(connectivity.getDelays());
+	//the amplitude of a spike is chosen by its population: 0 for the excitatory neurons, 1 for the inhibitory ones
+	const double amplitudes[2] = {ampl_e, ampl_i};
+	//the targets of a neuron are contiguous and sorted, the first one in the group is found once
+	const int begin(first*partition_size);
+	positions.resize(spikes.size());
+	for (size_t s(0); s<spikes.size(); ++s){
+		const int i(spikes[s].neuron);
+		positions[s] = std::lower_bound(targets + offsets[i], targets + offsets[i+1], begin) - targets;
+	}
+	std::uint64_t nb_deliveries(0);
+	for (int p(first); p<last; ++p){
+		const int end(std::min((p + 1)*partition_size, nb_neurons));
+		//the spikes of one time step are read in the order of the neurons,
+		//the spikes of different time steps are stored in different boxes
+		for (size_t s(0); s<spikes.size(); ++s){
+			const int i(spikes[s].neuron);
+			const double ampl(amplitudes[i >= nb_excitatory]);
+			//the box is read a delay after the spike, at least the window, so it has been cleared during this update
+			const std::size_t* spike_rows(&rows[spikes[s].step%nb_boxes]);
+			std::size_t k(positions[s]);
+			if (weights == nullptr and delays == nullptr){
+				k = scatter<false, false>(t_buffer, spike_rows, targets, weights, delays, k, offsets[i+1], end, ampl);
+			} else if (delays == nullptr){
+				k = scatter<true, false>(t_buffer, spike_rows, targets, weights, delays, k, offsets[i+1], end, ampl);
+			} else if (weights == nullptr){
+				k = scatter<false, true>(t_buffer, spike_rows, targets, weights, delays, k, offsets[i+1], end, ampl);
+			} else {
+				k = scatter<true, true>(t_buffer, spike_rows, targets, weights, delays, k, offsets[i+1], end, ampl);
+			}
+			nb_deliveries += k - positions[s];
+			positions[s] = k;
+		}
+	}
+	return nb_deliveries;
+}
+
+
+void updatePartition(MembraneKernel kernel, MembraneBlock block, float* t_buffer, const std::size_t* rows, int nb_boxes,
+					 const PoissonGenerator* noise, double amplitude, int first, unsigned int clock, int nb_steps,
+					 std::vector<Spike>& spikes)
+{
+	if (noise != nullptr){
+		updateSteps<true>(kernel, block, t_buffer, rows, nb_boxes, noise, amplitude, first, clock, nb_steps, spikes);
+	} else {
+		updateSteps<false>(kernel, block, t_buffer, rows, nb_boxes, noise, amplitude, first, clock, nb_steps, spikes);
+	}
+}
+
+std::uint64_t deliverSpikes(Connectivity const& connectivity, std::vector<Spike> const& spikes, float* t_buffer,
+							const std::size_t* rows, int nb_boxes, int nb_neurons, int nb_excitatory, int first, int last,
+							std::vector<std::size_t>& positions, double ampl_e, double ampl_i)
+{
+	if (connectivity.isNarrow()){
+		return sendSpikes(connectivity, connectivity.getNarrowTargets(), spikes, t_buffer, rows, nb_boxes, nb_neurons,
+						  nb_excitatory, first, last, positions, ampl_e, ampl_i);
+	}
+	return sendSpikes(connectivity, connectivity.getWideTargets(), spikes, t_buffer, rows, nb_boxes, nb_neurons,
+					  nb_excitatory, first, last, positions, ampl_e, ampl_i);
+}
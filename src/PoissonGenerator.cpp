@@ -0,0 +1,151 @@
+#include "PoissonGenerator.hpp"
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+
+constexpr std::uint64_t range (std::uint64_t(1) << 32); //!< Number of values of a random integer of 32 bits
+constexpr int guide_bits (8); //!< Number of highest bits of a random integer giving the first value to test
+constexpr int batch (16); //!< Number of counters of Philox computed together, the loops over them are vectorized
+
+//constants of Philox4x32
+constexpr std::uint32_t philox_M0 (0xD2511F53);
+constexpr std::uint32_t philox_M1 (0xCD9E8D57);
+constexpr std::uint32_t philox_W0 (0x9E3779B9);
+constexpr std::uint32_t philox_W1 (0xBB67AE85);
+
+
+PoissonGenerator::PoissonGenerator(double lambda, std::uint32_t seed)
+: lambda_(lambda),
+  seed_(seed)
+{
+	computeTables();
+}
+
+double PoissonGenerator::getLambda() const
+{
+	return lambda_;
+}
+
+std::uint32_t PoissonGenerator::getSeed() const
+{
+	return seed_;
+}
+
+void PoissonGenerator::setLambda(double lambda)
+{
+	if (lambda != lambda_){
+		lambda_ = lambda;
+		computeTables();
+	}
+}
+
+void PoissonGenerator::setSeed(std::uint32_t seed)
+{
+	seed_ = seed;
+}
+
+void PoissonGenerator::generate(std::uint32_t step, int first, int size, unsigned int* counts) const
+{
+	assert(first >= 0 and size >= 0);
+	if (thresholds_.size() == 1){
+		std::fill(counts, counts + size, 0u); //no spikes
+		return;
+	}
+	//the counter of the neuron i is i/4, its random integer is the number i%4 of the counter
+	const std::uint32_t last_block((first + size + 3)/4);
+	for (std::uint32_t block(first/4); block<last_block; block += batch){
+		const int nb_blocks(std::min<std::uint32_t>(batch, last_block - block));
+		std::uint32_t c0[batch], c1[batch], c2[batch], c3[batch];
+		for (int j(0); j<batch; ++j){
+			c0[j] = block + j;
+			c1[j] = step;
+			c2[j] = 0;
+			c3[j] = 0;
+		}
+		//the 10 rounds of Philox on all the counters of the batch
+		std::uint32_t k0(seed_), k1(0);
+		for (int round(0); round<10; ++round){
+			for (int j(0); j<batch; ++j){
+				const std::uint64_t product0(std::uint64_t(philox_M0)*c0[j]);
+				const std::uint64_t product1(std::uint64_t(philox_M1)*c2[j]);
+				const std::uint32_t x0(std::uint32_t(product1 >> 32) ^ c1[j] ^ k0);
+				const std::uint32_t x2(std::uint32_t(product0 >> 32) ^ c3[j] ^ k1);
+				c1[j] = std::uint32_t(product1);
+				c3[j] = std::uint32_t(product0);
+				c0[j] = x0;
+				c2[j] = x2;
+			}
+			k0 += philox_W0;
+			k1 += philox_W1;
+		}
+		//inversion of the distribution for the neurons of the block
+		for (int j(0); j<nb_blocks; ++j){
+			const std::uint32_t random[4] = {c0[j], c1[j], c2[j], c3[j]};
+			for (int lane(0); lane<4; ++lane){
+				const int i(4*(block + j) + lane);
+				if (i < first or i >= first + size){
+					continue;
+				}
+				const std::uint32_t u(random[lane]);
+				std::uint32_t k(guide_[u >> (32 - guide_bits)]);
+				while (u >= thresholds_[k]){
+					++k;
+				}
+				counts[i - first] = k;
+			}
+		}
+	}
+}
+
+void PoissonGenerator::philox(std::uint32_t counter[4], const std::uint32_t key[2])
+{
+	std::uint32_t k0(key[0]), k1(key[1]);
+	for (int round(0); round<10; ++round){
+		const std::uint64_t product0(std::uint64_t(philox_M0)*counter[0]);
+		const std::uint64_t product1(std::uint64_t(philox_M1)*counter[2]);
+		const std::uint32_t x0(std::uint32_t(product1 >> 32) ^ counter[1] ^ k0);
+		const std::uint32_t x2(std::uint32_t(product0 >> 32) ^ counter[3] ^ k1);
+		counter[1] = std::uint32_t(product1);
+		counter[3] = std::uint32_t(product0);
+		counter[0] = x0;
+		counter[2] = x2;
+		k0 += philox_W0;
+		k1 += philox_W1;
+	}
+}
+
+void PoissonGenerator::computeTables()
+{
+	assert(lambda_ >= 0.0 and lambda_ < 1e6);
+	thresholds_.clear();
+	if (lambda_ > 0.0){
+		//the probabilities are computed with logarithms, exp(-lambda) is too small for a big lambda
+		const int last(std::ceil(lambda_ + 12.0*std::sqrt(lambda_) + 20.0));
+		double cdf(0.0);
+		for (int k(0); k<last; ++k){
+			cdf += std::exp(k*std::log(lambda_) - lambda_ - std::lgamma(k + 1.0));
+			const std::uint64_t threshold(std::min<double>(range, std::round(cdf*range)));
+			thresholds_.push_back(threshold);
+			if (threshold >= range){
+				break;
+			}
+		}
+	}
+	//the last value is taken by all the random integers left
+	if (thresholds_.empty() or thresholds_.back() < range){
+		thresholds_.push_back(range);
+	}
+
+	guide_.assign(1 << guide_bits, 0);
+	std::uint32_t k(0);
+	for (std::uint64_t j(0); j<guide_.size(); ++j){
+		while (thresholds_[k] <= (j << (32 - guide_bits))){
+			++k;
+		}
+		guide_[j] = k;
+	}
+}
+
+PoissonGenerator::~PoissonGenerator()
+{}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include "PoissonGenerator.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <cmath>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * Compute the chi squared of a histogram of numbers of spikes compared to the poisson distribution,
+ * the values whose expected number is less than 5 are grouped with their neighbour
+*/
+
+static double chiSquared(std::vector<double> const& histogram, double lambda, int& degrees)
+{
+	double total(0.0);
+	for (auto const& count : histogram){
+		total += count;
+	}
+	double chi2(0.0), observed(0.0), expected(0.0), cdf(0.0);
+	degrees = -1;
+	for (size_t k(0); k<histogram.size(); ++k){
+		const double p(std::exp(k*std::log(lambda) - lambda - std::lgamma(k + 1.0)));
+		cdf += p;
+		observed += histogram[k];
+		//the last group contains all the values left
+		expected += (k+1 == histogram.size() ? 1.0 - cdf + p : p)*total;
+		if (expected >= 5.0 and (1.0 - cdf)*total >= 5.0){
+			chi2 += (observed - expected)*(observed - expected)/expected;
+			observed = expected = 0.0;
+			++degrees;
+		}
+	}
+	if (expected > 0.0){
+		chi2 += (observed - expected)*(observed - expected)/expected;
+		++degrees;
+	}
+	return chi2;
+}
+
+/*
+ * TEST1: Test if Philox gives the values of its reference implementation
+*/
+
+TEST (PoissonGeneratorTest, Philox){
+	std::uint32_t counter[4] = {0, 0, 0, 0};
+	const std::uint32_t key[2] = {0, 0};
+	PoissonGenerator::philox(counter, key);
+	EXPECT_EQ (0x6627e8d5u, counter[0]);
+	EXPECT_EQ (0xe169c58du, counter[1]);
+	EXPECT_EQ (0xbc57ac4cu, counter[2]);
+	EXPECT_EQ (0x9b00dbd8u, counter[3]);
+
+	std::uint32_t pi[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+	const std::uint32_t pi_key[2] = {0xa4093822, 0x299f31d0};
+	PoissonGenerator::philox(pi, pi_key);
+	EXPECT_EQ (0xd16cfe09u, pi[0]);
+	EXPECT_EQ (0x94fdccebu, pi[1]);
+	EXPECT_EQ (0x5001e420u, pi[2]);
+	EXPECT_EQ (0x24126ea1u, pi[3]);
+}
+
+/*
+ * TEST2: Test if the numbers drawn follow the poisson distribution, as the numbers of std::poisson_distribution
+ * used by the objects Neuron, for the means of the graphs of the Brunel's network and a bigger one
+*/
+
+TEST (PoissonGeneratorTest, Distribution){
+	const int nb_neurons(10000), nb_steps(100);
+	for (double lambda : {0.9, 2.0, 4.0, 30.0}){
+		PoissonGenerator generator (lambda, 17);
+		std::mt19937 gen(17);
+		std::poisson_distribution<> dis_ext (lambda);
+		std::vector<double> histogram(lambda*3 + 15, 0.0), reference(histogram.size(), 0.0);
+		std::vector<unsigned int> counts(nb_neurons);
+		double sum(0.0), sum2(0.0);
+		for (int step(0); step<nb_steps; ++step){
+			generator.generate(step, 0, nb_neurons, counts.data());
+			for (int i(0); i<nb_neurons; ++i){
+				++histogram[std::min<size_t>(counts[i], histogram.size()-1)];
+				++reference[std::min<size_t>(dis_ext(gen), histogram.size()-1)];
+				sum += counts[i];
+				sum2 += double(counts[i])*counts[i];
+			}
+		}
+		const double n(double(nb_neurons)*nb_steps);
+		const double mean(sum/n), variance(sum2/n - mean*mean);
+		//the standard deviation of the mean is sqrt(lambda/n)
+		EXPECT_NEAR (lambda, mean, 5.0*std::sqrt(lambda/n));
+		EXPECT_NEAR (lambda, variance, 0.01*lambda);
+		//both generators pass the same test, the limit is far in the tail of the chi squared distribution
+		int degrees(0), reference_degrees(0);
+		const double chi2(chiSquared(histogram, lambda, degrees));
+		const double reference_chi2(chiSquared(reference, lambda, reference_degrees));
+		EXPECT_LT (chi2, degrees + 5.0*std::sqrt(2.0*degrees)) << "lambda = " << lambda;
+		EXPECT_LT (reference_chi2, reference_degrees + 5.0*std::sqrt(2.0*reference_degrees)) << "lambda = " << lambda;
+	}
+}
+
+/*
+ * TEST3: Test if the number of a neuron depends only on the neuron and the time step,
+ * not on the block it is drawn with, and if the time steps and the seeds give different numbers
+*/
+
+TEST (PoissonGeneratorTest, Counter){
+	PoissonGenerator generator (2.0, 5);
+	std::vector<unsigned int> all(1000), part(1000), next(1000);
+	generator.generate(42, 0, 1000, all.data());
+	generator.generate(42, 0, 3, part.data());
+	generator.generate(42, 3, 250, part.data() + 3);
+	generator.generate(42, 253, 747, part.data() + 253);
+	EXPECT_EQ (all, part);
+	generator.generate(43, 0, 1000, next.data());
+	EXPECT_NE (all, next);
+	generator.setSeed(6);
+	generator.generate(42, 0, 1000, next.data());
+	EXPECT_NE (all, next);
+	//without noise all the numbers are 0
+	generator.setLambda(0.0);
+	generator.generate(42, 0, 1000, next.data());
+	EXPECT_EQ (std::vector<unsigned int>(1000, 0), next);
+}
@@ -0,0 +1,185 @@
+#include "PopulationMonitor.hpp"
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <algorithm>
+
+
+PopulationMonitor::PopulationMonitor(int nb_neurons, int nb_excitatory, double bin_width, std::string const& file_name,
+									 unsigned int start, double dt)
+: nb_neurons_(nb_neurons),
+  nb_excitatory_(nb_excitatory),
+  dt_(dt),
+  bin_steps_(std::max(1.0, std::round(bin_width/dt))),
+  start_(start),
+  end_(start),
+  bin_start_(start),
+  nb_bins_(0),
+  bin_spikes_{0, 0},
+  bin_potential_(0.0),
+  bin_samples_(0),
+  last_potential_(0.0),
+  nb_spikes_{0, 0},
+  potential_sum_(0.0),
+  count_sum_(0.0),
+  count_sum2_(0.0),
+  neuron_spikes_(nb_neurons, 0),
+  neuron_count_(nb_neurons, 0),
+  neuron_sum2_(nb_neurons, 0.0)
+{
+	assert(nb_neurons > 0 and nb_excitatory >= 0 and nb_excitatory <= nb_neurons);
+	assert(bin_width > 0.0 and dt > 0.0);
+	//each neuron is at most once in the list, it never grows
+	spiking_.reserve(nb_neurons);
+	if (not file_name.empty()){
+		file_.open(file_name.c_str());
+		assert(not file_.fail()); //check if the file opens correctly
+		file_ << "time_ms,spikes_e,spikes_i,rate_hz,rate_e_hz,rate_i_hz,potential_mv\n";
+	}
+}
+
+void PopulationMonitor::add(std::vector<Spike> const& spikes, unsigned int clock, double mean_potential)
+{
+	end_ = clock;
+	for (auto const& spike : spikes){
+		assert(spike.step >= bin_start_ and spike.step < clock); //the bins before are already written
+		assert(spike.neuron >= 0 and spike.neuron < nb_neurons_);
+		while (spike.step >= bin_start_ + bin_steps_){
+			closeBin();
+		}
+		const int i(spike.neuron);
+		++bin_spikes_[i < nb_excitatory_];
+		if (neuron_count_[i] == 0){
+			spiking_.push_back(i);
+		}
+		++neuron_count_[i];
+	}
+	//the potential is measured at the end of the window, in the bin of its last time step
+	while (clock > bin_start_ + bin_steps_){
+		closeBin();
+	}
+	bin_potential_ += mean_potential;
+	++bin_samples_;
+	last_potential_ = mean_potential;
+	if (clock == bin_start_ + bin_steps_){
+		closeBin();
+	}
+}
+
+void PopulationMonitor::finish(unsigned int nb_steps)
+{
+	end_ = nb_steps;
+	while (nb_steps > bin_start_){
+		closeBin();
+	}
+	if (file_.is_open()){
+		file_.flush();
+	}
+}
+
+unsigned int PopulationMonitor::getBinSteps() const
+{
+	return bin_steps_;
+}
+
+int PopulationMonitor::getNumberBins() const
+{
+	return nb_bins_;
+}
+
+std::uint64_t PopulationMonitor::getNumberSpikes(bool excitatory) const
+{
+	return nb_spikes_[excitatory];
+}
+
+double PopulationMonitor::getRate() const
+{
+	if (nb_bins_ == 0){
+		return 0.0;
+	}
+	//the rate is in Hz and the time step in milliseconds
+	return 1000.0*(nb_spikes_[0] + nb_spikes_[1])/(nb_neurons_*getDuration());
+}
+
+double PopulationMonitor::getRate(bool excitatory) const
+{
+	const int size(excitatory ? nb_excitatory_ : nb_neurons_ - nb_excitatory_);
+	if (nb_bins_ == 0 or size == 0){
+		return 0.0;
+	}
+	return 1000.0*nb_spikes_[excitatory]/(size*getDuration());
+}
+
+double PopulationMonitor::getMeanPotential() const
+{
+	return nb_bins_ > 0 ? potential_sum_/nb_bins_ : 0.0;
+}
+
+double PopulationMonitor::getSynchrony() const
+{
+	//only the complete bins are compared, as in SpikeAnalysis
+	const unsigned int nb_complete((std::min(bin_start_, end_) - start_)/bin_steps_);
+	const double n(nb_complete);
+	double neurons_variance(0.0);
+	for (int i(0); i<nb_neurons_ and nb_complete > 0; ++i){
+		const double mean(neuron_spikes_[i]/n);
+		neurons_variance += std::max(0.0, neuron_sum2_[i]/n - mean*mean);
+	}
+	if (not (neurons_variance > 0.0)){
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	const double mean(count_sum_/n);
+	const double population_variance(std::max(0.0, count_sum2_/n - mean*mean));
+	return population_variance/(neurons_variance/nb_neurons_);
+}
+
+double PopulationMonitor::getDuration() const
+{
+	//the last bin ends with the simulation
+	return (std::min(bin_start_, end_) - start_)*dt_;
+}
+
+void PopulationMonitor::closeBin()
+{
+	const std::uint64_t count(bin_spikes_[0] + bin_spikes_[1]);
+	const double potential(bin_samples_ > 0 ? bin_potential_/bin_samples_ : last_potential_);
+	if (file_.is_open()){
+		//the last bin can be shorter, it ends with the simulation
+		const double duration((std::min(end_, bin_start_ + bin_steps_) - bin_start_)*dt_/1000.0); //in seconds
+		const int nb_inhibitory(nb_neurons_ - nb_excitatory_);
+		file_ << bin_start_*dt_ << ',' << bin_spikes_[1] << ',' << bin_spikes_[0] << ','
+			  << count/(nb_neurons_*duration) << ','
+			  << (nb_excitatory_ > 0 ? bin_spikes_[1]/(nb_excitatory_*duration) : 0.0) << ','
+			  << (nb_inhibitory > 0 ? bin_spikes_[0]/(nb_inhibitory*duration) : 0.0) << ','
+			  << potential << '\n';
+	}
+
+	//a last bin shorter than the others is left out of the synchrony index
+	const bool complete(end_ >= bin_start_ + bin_steps_);
+	for (auto const& i : spiking_){
+		if (complete){
+			neuron_spikes_[i] += neuron_count_[i];
+			neuron_sum2_[i] += double(neuron_count_[i])*neuron_count_[i];
+		}
+		neuron_count_[i] = 0;
+	}
+	spiking_.clear();
+	if (complete){
+		const double population(double(count)/nb_neurons_);
+		count_sum_ += population;
+		count_sum2_ += population*population;
+	}
+	nb_spikes_[0] += bin_spikes_[0];
+	nb_spikes_[1] += bin_spikes_[1];
+	potential_sum_ += potential;
+
+	bin_spikes_[0] = 0;
+	bin_spikes_[1] = 0;
+	bin_potential_ = 0.0;
+	bin_samples_ = 0;
+	bin_start_ += bin_steps_;
+	++nb_bins_;
+}
+
+PopulationMonitor::~PopulationMonitor()
+{}
@@ -0,0 +1,106 @@
+#include <iostream>
+#include "PopulationMonitor.hpp"
+#include "SpikeAnalysis.hpp"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <string>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the spikes of each population are counted in their bins, the bins are written when
+ * they are complete and the potential of a bin without measure is the last one measured
+*/
+
+TEST (PopulationMonitorTest, Bins){
+	{
+		//8 excitatory and 2 inhibitory neurons, bins of 10 time steps
+		PopulationMonitor monitor (10, 8, 1.0, "test_population.csv");
+		EXPECT_EQ (10u, monitor.getBinSteps());
+		monitor.add({{0, 0}, {3, 9}, {12, 1}}, 15, -1.0);
+		EXPECT_EQ (1, monitor.getNumberBins()); //the second bin isn't complete
+		monitor.add({{17, 0}}, 30, 1.0);
+		EXPECT_EQ (3, monitor.getNumberBins());
+		monitor.finish(30);
+		EXPECT_EQ (3, monitor.getNumberBins());
+		EXPECT_EQ (3u, monitor.getNumberSpikes(true));
+		EXPECT_EQ (1u, monitor.getNumberSpikes(false));
+		EXPECT_NEAR (4*1000.0/(10*30*h), monitor.getRate(), 1e-9);
+		EXPECT_NEAR (3*1000.0/(8*30*h), monitor.getRate(true), 1e-9);
+		EXPECT_NEAR (1*1000.0/(2*30*h), monitor.getRate(false), 1e-9);
+		EXPECT_NEAR (0.0, monitor.getMeanPotential(), 1e-12); //0, -1 and 1
+	}
+
+	std::ifstream file ("test_population.csv");
+	std::string line;
+	std::getline(file, line);
+	EXPECT_EQ ("time_ms,spikes_e,spikes_i,rate_hz,rate_e_hz,rate_i_hz,potential_mv", line);
+	std::getline(file, line);
+	EXPECT_EQ ("0,1,1,200,125,500,0", line);
+	std::getline(file, line);
+	EXPECT_EQ ("1,2,0,200,250,0,-1", line);
+	std::getline(file, line);
+	EXPECT_EQ ("2,0,0,0,0,0,1", line);
+	EXPECT_FALSE (std::getline(file, line));
+}
+
+/*
+ * TEST2: Test if the rates of the last bin are divided by the time steps it covers
+ * when the duration isn't a multiple of the width of the bins
+*/
+
+TEST (PopulationMonitorTest, PartialBin){
+	{
+		PopulationMonitor monitor (10, 8, 1.0, "test_population.csv");
+		//the spike at 12 closes the first bin after a window ending before its end
+		monitor.add({{0, 0}}, 5, 0.0);
+		monitor.add({{12, 9}}, 15, 0.0);
+		monitor.finish(15);
+		EXPECT_EQ (2, monitor.getNumberBins());
+		EXPECT_NEAR (2*1000.0/(10*15*h), monitor.getRate(), 1e-9);
+	}
+
+	std::ifstream file ("test_population.csv");
+	std::string line;
+	std::getline(file, line);
+	std::getline(file, line);
+	EXPECT_EQ ("0,1,0,100,125,0,0", line); //the whole bin of 10 time steps
+	std::getline(file, line);
+	EXPECT_EQ ("1,0,1,200,0,1000,0", line); //5 time steps
+	EXPECT_FALSE (std::getline(file, line));
+}
+
+/*
+ * TEST3: Test if the rate and the synchrony index computed during the simulation are the same
+ * as the ones of SpikeAnalysis with all the spikes
+*/
+
+TEST (PopulationMonitorTest, SameAsAnalysis){
+	Network network(800, 200, 7);
+	network.addConnections(8, 80, 20);
+	PopulationMonitor monitor (1000, 800, 1.0);
+	SpikeAnalysis analysis (1000, 1.0);
+	const unsigned int nb_steps(1000);
+	while (network.getClock() < nb_steps){
+		network.update(5, 2, D);
+		for (auto const& spike : network.getLastSpikes()){
+			analysis.add(spike);
+		}
+		monitor.add(network.getLastSpikes(), network.getClock(), network.getMeanV_membrane());
+	}
+	//the last window ends after the duration
+	analysis.finish(network.getClock());
+	monitor.finish(network.getClock());
+	EXPECT_EQ (analysis.getNumberBins(), monitor.getNumberBins());
+	EXPECT_GT (monitor.getNumberSpikes(true), 0u);
+	EXPECT_NEAR (analysis.getMeanRate(), monitor.getRate(), 1e-9);
+	EXPECT_NEAR (analysis.getSynchrony(), monitor.getSynchrony(), 1e-9);
+	EXPECT_GT (monitor.getMeanPotential(), 0.0);
+	EXPECT_LT (monitor.getMeanPotential(), V_thr);
+}
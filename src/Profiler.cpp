@@ -0,0 +1,145 @@
+#include "Profiler.hpp"
+#include "Neuron.hpp"
+#include <chrono>
+#include <cassert>
+
+
+Profiler::Profiler(int nb_neurons, std::string const& trace_file, unsigned int report_interval, std::ostream& output)
+: nb_neurons_(nb_neurons),
+  report_interval_(report_interval),
+  output_(output),
+  nb_spikes_(0),
+  nb_deliveries_(0),
+  nb_steps_(0),
+  report_spikes_(0),
+  report_deliveries_(0),
+  report_steps_(0),
+  report_start_(now())
+{
+	times_.fill(0.0);
+	window_times_.fill(0.0);
+	if (not trace_file.empty()){
+		trace_.open(trace_file.c_str());
+		assert(not trace_.fail()); //check if the file opens correctly
+		trace_ << "step,nb_steps,spikes,deliveries";
+		for (int p(0); p<nb_phases; ++p){
+			trace_ << "," << getName(Phase(p)) << "_s";
+		}
+		trace_ << ",step_spikes\n";
+	}
+}
+
+double Profiler::now()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string Profiler::getName(Phase phase)
+{
+	switch (phase){
+		case Phase::initialization:
+			return "initialization";
+		case Phase::wiring:
+			return "wiring";
+		case Phase::integration:
+			return "integration";
+		case Phase::delivery:
+			return "delivery";
+		default:
+			return "recording";
+	}
+}
+
+double Profiler::getTime(Phase phase) const
+{
+	return times_[int(phase)];
+}
+
+std::uint64_t Profiler::getNumberSpikes() const
+{
+	return nb_spikes_;
+}
+
+std::uint64_t Profiler::getNumberDeliveries() const
+{
+	return nb_deliveries_;
+}
+
+std::uint64_t Profiler::getNumberSteps() const
+{
+	return nb_steps_;
+}
+
+void Profiler::addTime(Phase phase, double seconds)
+{
+	times_[int(phase)] += seconds;
+	window_times_[int(phase)] += seconds;
+}
+
+void Profiler::addWindow(unsigned int clock, int nb_steps, std::uint64_t nb_spikes, std::uint64_t nb_deliveries,
+						 std::vector<unsigned int> const& step_spikes)
+{
+	assert(step_spikes.empty() or int(step_spikes.size()) == nb_steps);
+	nb_steps_ += nb_steps;
+	nb_spikes_ += nb_spikes;
+	nb_deliveries_ += nb_deliveries;
+	report_steps_ += nb_steps;
+	report_spikes_ += nb_spikes;
+	report_deliveries_ += nb_deliveries;
+	if (trace_.is_open()){
+		trace_ << clock << "," << nb_steps << "," << nb_spikes << "," << nb_deliveries;
+		for (auto const& t : window_times_){
+			trace_ << "," << t;
+		}
+		trace_ << ",";
+		for (size_t k(0); k<step_spikes.size(); ++k){
+			trace_ << (k > 0 ? ";" : "") << step_spikes[k];
+		}
+		trace_ << "\n";
+	}
+	window_times_.fill(0.0);
+	if (report_interval_ > 0 and clock/report_interval_ != (clock - nb_steps)/report_interval_){
+		report(clock);
+	}
+}
+
+void Profiler::printSummary()
+{
+	double total(0.0);
+	for (auto const& t : times_){
+		total += t;
+	}
+	output_ << "Profile of " << nb_steps_ << " time steps (" << total << " s):" << std::endl;
+	for (int p(0); p<nb_phases; ++p){
+		output_ << "  " << getName(Phase(p)) << ": " << times_[p] << " s ("
+				<< (total > 0.0 ? 100.0*times_[p]/total : 0.0) << " %)" << std::endl;
+	}
+	const double simulation_time(times_[int(Phase::integration)] + times_[int(Phase::delivery)]
+								 + times_[int(Phase::recording)]);
+	output_ << "  " << nb_spikes_ << " spikes, " << nb_deliveries_ << " synaptic events delivered";
+	if (simulation_time > 0.0){
+		output_ << ", " << nb_deliveries_/simulation_time << " events per second";
+	}
+	output_ << std::endl;
+}
+
+void Profiler::report(unsigned int clock)
+{
+	const double end(now());
+	const double elapsed(end - report_start_);
+	//mean firing rate of a neuron in Hz
+	const double rate(nb_neurons_ > 0 ? report_spikes_/(nb_neurons_*report_steps_*h*1e-3) : 0.0);
+	output_ << clock*h << " ms: " << rate << " Hz, " << report_deliveries_ << " events delivered ("
+			<< report_deliveries_/elapsed << " per second), " << report_steps_/elapsed << " steps per second" << std::endl;
+	if (rate > high_rate){
+		output_ << "High firing rate: the delivery of the spikes takes " << report_deliveries_/report_steps_
+				<< " events per time step" << std::endl;
+	}
+	report_spikes_ = 0;
+	report_deliveries_ = 0;
+	report_steps_ = 0;
+	report_start_ = end;
+}
+
+Profiler::~Profiler()
+{}
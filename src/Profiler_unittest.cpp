@@ -0,0 +1,74 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include "Profiler.hpp"
+#include "Neuron.hpp"
+#include "gtest/gtest.h"
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the durations and the activity of the windows are added and written in the trace,
+ * one line per window with the spikes of each time step
+*/
+
+TEST (ProfilerTest, Trace){
+	{
+		std::ostringstream output;
+		Profiler profiler(1000, "test_profile.csv", 0, output);
+		profiler.addTime(Phase::wiring, 2.0);
+		for (int t(1); t<=3; ++t){
+			profiler.addTime(Phase::integration, 0.5);
+			profiler.addTime(Phase::delivery, 0.25);
+			std::vector<unsigned int> step_spikes(D, 0);
+			step_spikes[0] = 10*t;
+			profiler.addWindow(t*D, D, 10*t, 100*t, t < 3 ? step_spikes : std::vector<unsigned int>());
+		}
+		EXPECT_EQ (2.0, profiler.getTime(Phase::wiring));
+		EXPECT_EQ (1.5, profiler.getTime(Phase::integration));
+		EXPECT_EQ (3u*D, profiler.getNumberSteps());
+		EXPECT_EQ (60u, profiler.getNumberSpikes());
+		EXPECT_EQ (600u, profiler.getNumberDeliveries());
+		EXPECT_TRUE (output.str().empty()); //no summary without interval
+	}
+	std::ifstream trace ("test_profile.csv");
+	std::string line;
+	std::getline(trace, line);
+	EXPECT_EQ ("step,nb_steps,spikes,deliveries,initialization_s,wiring_s,integration_s,delivery_s,recording_s,step_spikes", line);
+	std::getline(trace, line);
+	//the wiring is counted in the first window
+	EXPECT_EQ ("15,15,10,100,0,2,0.5,0.25,0,10;0;0;0;0;0;0;0;0;0;0;0;0;0;0", line);
+	std::getline(trace, line);
+	EXPECT_EQ ("30,15,20,200,0,0,0.5,0.25,0,20;0;0;0;0;0;0;0;0;0;0;0;0;0;0", line);
+	std::getline(trace, line);
+	EXPECT_EQ ("45,15,30,300,0,0,0.5,0.25,0,", line); //without the counts of the time steps
+}
+
+/*
+ * TEST2: Test if a summary is printed at each interval and warns when the firing rate is high
+*/
+
+TEST (ProfilerTest, Report){
+	std::ostringstream output;
+	Profiler profiler(100, "", 1000, output);
+	//10 spikes per time step for 100 neurons: 1000 Hz
+	for (int t(1); t<=100; ++t){
+		profiler.addWindow(t*10, 10, 100, 10000);
+	}
+	const std::string summaries (output.str());
+	EXPECT_NE (std::string::npos, summaries.find("100 ms: 1000 Hz"));
+	EXPECT_NE (std::string::npos, summaries.find("High firing rate"));
+	EXPECT_EQ (std::string::npos, summaries.find("200 ms")); //only one interval
+
+	std::ostringstream quiet;
+	Profiler low(100, "", 1000, quiet);
+	low.addWindow(1000, 1000, 10, 0); //1 Hz
+	EXPECT_NE (std::string::npos, quiet.str().find("1 Hz"));
+	EXPECT_EQ (std::string::npos, quiet.str().find("High firing rate"));
+}
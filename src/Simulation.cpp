@@ -1,12 +1,57 @@
 #include "Simulation.hpp"
+#include "Sweep.hpp"
+#include "PopulationMonitor.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include <cmath>
 
 
-Simulation::Simulation()
+Simulation::Simulation(Parameters const& parameters)
+: parameters_(parameters)
 {}
+
+void Simulation::run()
+{
+	if (parameters_.mode == "one"){
+		oneNeuronSimulation();
+	} else if (parameters_.mode == "two"){
+		twoNeruonsSimulation();
+	} else if (parameters_.mode == "A"){
+		plotGraph_A();
+	} else if (parameters_.mode == "B"){
+		plotGraph_B();
+	} else if (parameters_.mode == "C"){
+		plotGraph_C();
+	} else if (parameters_.mode == "D"){
+		plotGraph_D();
+	} else if (parameters_.isSweep()){
+		sweep();
+	} else {
+		networkSimulation(parameters_.g[0], parameters_.rate[0]);
+	}
+}
+
+void Simulation::sweep()
+{
+	//the connections are created once and several points are simulated at the same time
+	Sweep sweep (parameters_, parameters_.record);
+	std::cout << "Simulation of " << sweep.getNumberPoints() << " points" << std::endl;
+	sweep.run();
+	for (int k(0); k<sweep.getNumberPoints(); ++k){
+		SweepPoint const& point (sweep.getPoint(k));
+		std::cout << "g = " << point.g << ", nu_ext/nu_thr = " << point.rate << ": " << point.mean_rate << " Hz, synchrony "
+				  << point.synchrony << ", CV " << point.cv << ", " << point.regime << std::endl;
+	}
+	//the summary of all the points is written in output_sweep.csv
+	sweep.write(parameters_.output + "_sweep.csv");
+}
+
 void Simulation::oneNeuronSimulation()
 {
 	Neuron n(true); 
@@ -18,6 +63,7 @@ void Simulation::oneNeuronSimulation()
 	
 	n.setExternalInput(externalInput());
 	
+	const int end_time(parameters_.getNumberSteps()*N);
 	int simulation_time = t_start; 
 	//update all the neurons of the simulation
 	do { 
@@ -29,7 +75,7 @@ void Simulation::oneNeuronSimulation()
 		simulation_time += N; //the simulation time advanced of a time step N
 		//the membrane potential is stored in Datas.txt
 		file << "Membrane potential at " << simulation_time*h << " milliseconds: " << n.getV_membrane() << std::endl; 
-	} while (simulation_time < t_stop); 
+	} while (simulation_time < end_time); 
 }
 
 void Simulation::twoNeruonsSimulation()
@@ -41,6 +87,7 @@ void Simulation::twoNeruonsSimulation()
 	 //the external input is added only to the spiking neuron
 	neuron1.setExternalInput(externalInput());
 	
+	const int end_time(parameters_.getNumberSteps()*N);
 	int simulation_time = t_start;
 	//update all the neurons of the simulation
 	do {
@@ -55,47 +102,223 @@ void Simulation::twoNeruonsSimulation()
 			std::cout << "A spike occured at time: " << simulation_time*h << std::endl;
 		}
 		simulation_time += N; //the simulation time advanced of a time step N
-	} while (simulation_time < t_stop); 
+	} while (simulation_time < end_time); 
 	
 }
 	
-void Simulation::networkSimulation(double g, double pois)
+void Simulation::networkSimulation(double g, double pois, std::string const& file_name)
 {
-	//open a file to store the time of all the spikes and the neuron spiking id
-	std::ofstream file2; 
-	file2.open("Spike_time.txt");
-	assert (not file2.fail());  //check if the file opens correctly
-
-	//initiliaze the array representing the network of 12500 neurons
-	std::array <Neuron*, total_neurons> neurons;
-	initializeNeurons(neurons);
+	const bool delayed(parameters_.getMinDelay() != D or parameters_.getMaxDelay() != D);
+	if (delayed and (parameters_.engine == "event" or parameters_.transport != "none")){
+		std::cout << "The delays are only available with the step engine without transport, D is used" << std::endl;
+	}
+	if (parameters_.engine == "event"){
+		eventSimulation(g, pois, file_name);
+		return;
+	}
+	if (parameters_.transport != "none"){
+		distributedSimulation(g, pois, file_name);
+		return;
+	}
+#ifdef PROFILING
+	double start(Profiler::now());
+#endif
+	//the network stores all the neurons in contiguous arrays
+	Network network (parameters_.nb_excitatory, parameters_.nb_inhibitory, parameters_.noise_seed);
+	network.setAmplitude(parameters_.J);
+
+	//the times of all the spikes and the neuron spiking id are stored in a binary file, unless only the rates are needed
+	std::unique_ptr<SpikeRecorder> recorder;
+	if (parameters_.record){
+		recorder.reset(new SpikeRecorder(file_name.empty() ? parameters_.output + ".bin" : file_name,
+										 network.getNumberNeurons(), g, pois));
+	}
+	//the neurons are updated by all the cores of the computer, unless an other number of threads is chosen
+	network.setNumberThreads(parameters_.threads);
+	std::cout << "Network initialized" << std::endl;
+#ifdef PROFILING
+	//the phases are written in output_profile.csv and summarized every 100 milliseconds
+	Profiler profiler (network.getNumberNeurons(), parameters_.output + "_profile.csv", std::round(100.0/h));
+	profiler.addTime(Phase::initialization, Profiler::now() - start);
+	start = Profiler::now();
+#endif
 	
-	//add the connections between each neuron
-	for (auto const& n : neurons){
-		n->addConnections(neurons);	
+	if (parameters_.restart.empty()){
+		//add the connections between each neuron
+		if (delayed){
+			//the delays are drawn after the connections, with their own seed
+			std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(network.getNumberNeurons()));
+			connectivity->addRandomConnections(parameters_.nb_excitatory, parameters_.conn_e, parameters_.conn_i,
+												parameters_.seed, parameters_.threads);
+			connectivity->addRandomDelays(parameters_.getMinDelay(), parameters_.getMaxDelay(), parameters_.seed + 1);
+			network.setConnectivity(connectivity);
+		} else {
+			network.addConnections(parameters_.seed, parameters_.conn_e, parameters_.conn_i);
+		}
+		std::cout << "Connections added" << std::endl;
+	} else {
+		//the neurons, the connections and the noises continue from the saved state
+		network.loadCheckpoint(parameters_.restart);
+		std::cout << "Network restored at " << network.getClock()*h << " milliseconds" << std::endl;
 	}
-	std::cout << "Connections added" << std::endl;
+#ifdef PROFILING
+	profiler.addTime(Phase::wiring, Profiler::now() - start);
+#endif
+	//the memory of the neurons and of the synapses, the connections are the main part
+	const std::size_t nb_connections(network.getConnectivity()->getNumberConnections());
+	std::cout << "Memory: " << double(network.getMemory())/network.getNumberNeurons() << " bytes per neuron, "
+			  << (nb_connections > 0 ? double(network.getConnectivity()->getMemory())/nb_connections : 0.0)
+			  << " bytes per synapse" << std::endl;
 	
-	int simulation_time = t_start; 
+	const int end_time(parameters_.getNumberSteps()*N);
+	const int checkpoint_steps(std::round(parameters_.checkpoint_interval/h));
+	int simulation_time = network.getClock(); 
+	//the rates of the populations are computed during the simulation and written in output_population.csv
+	std::unique_ptr<PopulationMonitor> monitor;
+	if (parameters_.monitor > 0.0){
+		monitor.reset(new PopulationMonitor(network.getNumberNeurons(), network.getNumberExcitatory(), parameters_.monitor,
+											parameters_.output + "_population.csv", simulation_time));
+	}
+#ifdef PROFILING
+	std::vector<unsigned int> step_spikes; //number of spikes of each time step of the window
+#endif
+	//the rate nu_ext/nu_thr gives the mean number of external spikes per time step
+	const double noise(parameters_.getPoissonMean(pois));
 	//update all the neurons present in the network
-	do {
-		for (size_t i(0); i<neurons.size(); ++i){ 
-			assert (neurons[i] != nullptr); //check always that the neurons aren't nullptr
-			//update with the noises given by random spikes
-			neurons[i]->update(N, neurons[i]->randomSpikes(pois), g);  
-			if (neurons[i]->getSpikeState()){ 
-				//when a neuron spikes, write down the time and the index of the neuron
-				file2 << neurons[i]->getTimeSpike()/h << '\t' << i << '\n';
-			}
+	while (simulation_time < end_time) {
+		//the neurons are updated during a window of at most the shortest delay before the spikes are exchanged
+		const int nb_steps(std::min({parameters_.window, network.getMinDelay(), (end_time - simulation_time)/N}));
+		//update with the noises given by random spikes
+		network.update(g, noise, nb_steps);
+#ifdef PROFILING
+		start = Profiler::now();
+#endif
+		//the list of the spiking neurons is read directly, the other neurons are not polled
+		std::vector<Spike> const& spikes(network.getLastSpikes());
+		//when a neuron spikes, write down the time and the index of the neuron
+		if (recorder){
+			recorder->record(spikes);
 		}
-		simulation_time += N; //the simulation time advanced of a time step N after all neuron clocks have already advanced
-	} while (simulation_time < t_stop); 
-	
-	
-	//at the end of the simulation the memory has to be desallocated
-	for (auto& n : neurons){ 
-		n = nullptr;
-		delete n;
+		simulation_time += nb_steps*N; //the simulation time advanced of nb_steps time steps after the clock of the network has already advanced
+		if (monitor){
+			monitor->add(spikes, simulation_time, network.getMeanV_membrane());
+		}
+#ifdef PROFILING
+		profiler.addTime(Phase::recording, Profiler::now() - start);
+		profiler.addTime(Phase::integration, network.getIntegrationTime());
+		profiler.addTime(Phase::delivery, network.getDeliveryTime());
+		step_spikes.assign(nb_steps, 0);
+		for (auto const& spike : spikes){
+			++step_spikes[(spike.step - (simulation_time - nb_steps*N))/N];
+		}
+		profiler.addWindow(simulation_time, nb_steps, spikes.size(), network.getNumberDeliveries(), step_spikes);
+#endif
+		//the state is saved regularly, so the simulation can be continued if it's stopped
+		if (not parameters_.checkpoint.empty() and checkpoint_steps > 0
+			and simulation_time/checkpoint_steps != (simulation_time - nb_steps*N)/checkpoint_steps){
+			network.saveCheckpoint(parameters_.checkpoint);
+		}
+	}
+	if (not parameters_.checkpoint.empty()){
+		network.saveCheckpoint(parameters_.checkpoint);
+	}
+	if (monitor){
+		monitor->finish(end_time);
+		std::cout << "Population: " << monitor->getRate() << " Hz (excitatory " << monitor->getRate(true)
+				  << " Hz, inhibitory " << monitor->getRate(false) << " Hz), mean potential " << monitor->getMeanPotential()
+				  << " mV, synchrony " << monitor->getSynchrony() << std::endl;
+	}
+#ifdef PROFILING
+	profiler.printSummary();
+#endif
+}
+
+void Simulation::eventSimulation(double g, double pois, std::string const& file_name)
+{
+	if (not parameters_.checkpoint.empty() or not parameters_.restart.empty()){
+		std::cout << "The checkpoints are not available with the event engine, they are ignored" << std::endl;
+	}
+	EventNetwork network (parameters_.nb_excitatory, parameters_.nb_inhibitory, parameters_.noise_seed);
+	network.setAmplitude(parameters_.J);
+	std::unique_ptr<SpikeRecorder> recorder;
+	if (parameters_.record){
+		recorder.reset(new SpikeRecorder(file_name.empty() ? parameters_.output + ".bin" : file_name,
+										 network.getNumberNeurons(), g, pois));
+	}
+	network.addConnections(parameters_.seed, parameters_.conn_e, parameters_.conn_i);
+	std::cout << "Connections added" << std::endl;
+
+	const int end_time(parameters_.getNumberSteps()*N);
+	int simulation_time = network.getClock();
+	const double noise(parameters_.getPoissonMean(pois));
+	std::vector<Spike> spikes;
+	while (simulation_time < end_time) {
+		//the spikes are written after each window, as with the other engine
+		const int nb_steps(std::min({parameters_.window, D, (end_time - simulation_time)/N}));
+		network.update(g, noise, nb_steps);
+		spikes.clear();
+		network.getSpikes(spikes);
+		if (recorder){
+			recorder->record(spikes);
+		}
+		simulation_time += nb_steps*N;
+	}
+	std::cout << network.getNumberEvents() << " events for " << double(network.getNumberNeurons())*simulation_time
+			  << " neuron updates of the step engine" << std::endl;
+}
+
+void Simulation::distributedSimulation(double g, double pois, std::string const& file_name)
+{
+	if (not parameters_.checkpoint.empty() or not parameters_.restart.empty()){
+		std::cout << "The checkpoints are not available with several ranks, they are ignored" << std::endl;
+	}
+	const std::string name (file_name.empty() ? parameters_.output + ".bin" : file_name);
+	if (parameters_.transport == "mpi"){
+#ifdef USE_MPI
+		std::shared_ptr<Transport> transport (std::make_shared<MpiTransport>());
+		simulateRank(transport, parameters_.threads, g, pois, name);
+#else
+		std::cout << "The program is compiled without MPI, use the local transport" << std::endl;
+#endif
+		return;
+	}
+	//the ranks are threads of this process, the threads of the simulation are divided between them
+	std::vector<std::shared_ptr<Transport>> transports (LocalTransport::createGroup(parameters_.ranks));
+	const int nb_threads(std::max(1, parameters_.threads/parameters_.ranks));
+	std::vector<std::thread> ranks;
+	for (auto const& transport : transports){
+		ranks.push_back(std::thread(&Simulation::simulateRank, this, transport, nb_threads, g, pois, name));
+	}
+	for (auto& rank : ranks){
+		rank.join();
+	}
+}
+
+void Simulation::simulateRank(std::shared_ptr<Transport> transport, int nb_threads, double g, double pois, std::string const& file_name)
+{
+	DistributedNetwork network (parameters_.nb_excitatory, parameters_.nb_inhibitory, parameters_.noise_seed, transport);
+	network.setAmplitude(parameters_.J);
+	network.setNumberThreads(nb_threads);
+	//every rank knows all the spikes, only the rank 0 writes them
+	std::unique_ptr<SpikeRecorder> recorder;
+	if (transport->getRank() == 0){
+		if (parameters_.record){
+			recorder.reset(new SpikeRecorder(file_name, network.getNumberNeurons(), g, pois));
+		}
+		std::cout << "Network initialized on " << transport->getNumberRanks() << " ranks" << std::endl;
+	}
+	network.addConnections(parameters_.seed, parameters_.conn_e, parameters_.conn_i);
+
+	const int end_time(parameters_.getNumberSteps()*N);
+	int simulation_time = network.getClock();
+	const double noise(parameters_.getPoissonMean(pois));
+	while (simulation_time < end_time) {
+		const int nb_steps(std::min({parameters_.window, D, (end_time - simulation_time)/N}));
+		network.update(g, noise, nb_steps);
+		if (recorder){
+			recorder->record(network.getLastSpikes());
+		}
+		simulation_time += nb_steps*N;
 	}
 }
 
@@ -125,29 +348,24 @@ void Simulation::plotGraph_D()
 
 double Simulation::externalInput()
 {
+	if (not std::isnan(parameters_.external_input)){
+		return parameters_.external_input;
+	}
 	double input(0.0); 
 	std::cout << "Choose a value for the external input" << std::endl;
 	std::cin>>input;
 	return input;
 }
 
-void Simulation::initializeNeurons(std::array <Neuron*, total_neurons>& ns)
-{
-	Neuron n_excitatory(true);
-	Neuron n_inhibitory (false);
-	for (size_t i(0); i<ns.size(); ++i){
-		if (i<excitatory_neurons){//from 0 to 9999 the neurons are excitatory
-			ns[i] = new Neuron(n_excitatory);
-		} else {
-			ns[i] = new Neuron (n_inhibitory);//from 9999 to 12499 the neurons are inhibitory
-		}
-		assert(ns[i] != nullptr); //check that no neurons in the end is nullptr
-	}
-	std::cout << "Network initialized" << std::endl;
-}
-
 void Simulation::pythonScript()
 {
+	//without recording there is no spike file to draw
+	if (not parameters_.record){
+		std::cout << "The spikes are not recorded (--record 0), no graph is drawn" << std::endl;
+		return;
+	}
+	//the python script reads the spikes in the text file Spike_time.txt
+	SpikeRecorder::convertToText(parameters_.output + ".bin", "Spike_time.txt");
 	std::string name ("python ../Graphs.py &");
 	system (name.c_str()); //name stays constant
 }
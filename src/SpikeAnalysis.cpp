@@ -0,0 +1,225 @@
+#include "SpikeAnalysis.hpp"
+#include <fstream>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <algorithm>
+
+
+SpikeAnalysis::SpikeAnalysis(int nb_neurons, double bin_width, double dt)
+: nb_neurons_(nb_neurons),
+  dt_(dt),
+  bin_steps_(std::max(1.0, std::round(bin_width/dt))),
+  nb_steps_(0),
+  last_step_(0),
+  nb_spikes_(nb_neurons, 0),
+  last_spike_(nb_neurons, -1),
+  isi_sum_(nb_neurons, 0.0),
+  isi_sum2_(nb_neurons, 0.0),
+  bin_(nb_neurons, 0),
+  bin_count_(nb_neurons, 0),
+  count_sum2_(nb_neurons, 0.0)
+{
+	assert(nb_neurons > 0 and bin_width > 0.0 and dt > 0.0);
+}
+
+void SpikeAnalysis::add(Spike const& spike)
+{
+	assert(spike.step >= last_step_); //the spikes are sorted by time step
+	assert(spike.neuron >= 0 and spike.neuron < nb_neurons_);
+	const int i(spike.neuron);
+	last_step_ = spike.step;
+
+	const unsigned int b(spike.step/bin_steps_);
+	if (b >= bins_.size()){
+		bins_.resize(b+1, 0);
+	}
+	++bins_[b];
+
+	++nb_spikes_[i];
+	if (last_spike_[i] >= 0){
+		const double isi(spike.step - last_spike_[i]);
+		isi_sum_[i] += isi;
+		isi_sum2_[i] += isi*isi;
+	}
+	last_spike_[i] = spike.step;
+
+	//the spikes of the previous bin of the neuron are counted when it changes of bin
+	if (b != bin_[i]){
+		closeBin(i);
+		bin_[i] = b;
+	}
+	++bin_count_[i];
+}
+
+void SpikeAnalysis::add(SpikeReader const& reader)
+{
+	const std::uint32_t* records(reader.getRecords());
+	for (std::uint64_t k(0); k<reader.getNumberSpikes(); ++k){
+		add(Spike {records[2*k], int(records[2*k+1])});
+	}
+}
+
+void SpikeAnalysis::finish(unsigned int nb_steps)
+{
+	assert(bins_.empty() or nb_steps > last_step_);
+	nb_steps_ = nb_steps;
+	bins_.resize((nb_steps + bin_steps_ - 1)/bin_steps_, 0);
+	//the spikes of a last bin shorter than the others stay in bin_count_, out of the Fano factor and the synchrony
+	const unsigned int nb_complete(nb_steps/bin_steps_);
+	for (int i(0); i<nb_neurons_; ++i){
+		if (bin_[i] < nb_complete){
+			closeBin(i);
+		}
+	}
+}
+
+unsigned int SpikeAnalysis::getBinSteps() const
+{
+	return bin_steps_;
+}
+
+int SpikeAnalysis::getNumberBins() const
+{
+	return bins_.size();
+}
+
+std::uint64_t SpikeAnalysis::getBinCount(int b) const
+{
+	return bins_[b];
+}
+
+double SpikeAnalysis::getPopulationRate(int b) const
+{
+	//the last bin can be shorter, it ends with the simulation
+	const unsigned int end(nb_steps_ > 0 ? std::min(nb_steps_, (b+1)*bin_steps_) : (b+1)*bin_steps_);
+	//the rate is in Hz and the time step in milliseconds
+	return 1000.0*bins_[b]/(nb_neurons_*(end - b*bin_steps_)*dt_);
+}
+
+unsigned int SpikeAnalysis::getNumberSpikes(int i) const
+{
+	return nb_spikes_[i];
+}
+
+double SpikeAnalysis::getRate(int i) const
+{
+	//before the end or for an empty simulation there is no rate
+	if (nb_steps_ == 0){
+		return 0.0;
+	}
+	return 1000.0*nb_spikes_[i]/(nb_steps_*dt_);
+}
+
+double SpikeAnalysis::getCV(int i) const
+{
+	if (nb_spikes_[i] < 3){
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	const double n(nb_spikes_[i] - 1);
+	const double mean(isi_sum_[i]/n);
+	const double variance(std::max(0.0, isi_sum2_[i]/n - mean*mean));
+	return std::sqrt(variance)/mean;
+}
+
+double SpikeAnalysis::getFano(int i) const
+{
+	//only the complete bins are compared, the bins without spikes count for 0
+	const unsigned int count(nb_spikes_[i] - bin_count_[i]);
+	if (count == 0){
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	const double n(nb_steps_/bin_steps_);
+	const double mean(count/n);
+	const double variance(std::max(0.0, count_sum2_[i]/n - mean*mean));
+	return variance/mean;
+}
+
+double SpikeAnalysis::getMeanRate() const
+{
+	double sum(0.0);
+	for (int i(0); i<nb_neurons_; ++i){
+		sum += getRate(i);
+	}
+	return sum/nb_neurons_;
+}
+
+double SpikeAnalysis::getMeanCV() const
+{
+	double sum(0.0);
+	int n(0);
+	for (int i(0); i<nb_neurons_; ++i){
+		if (nb_spikes_[i] >= 3){
+			sum += getCV(i);
+			++n;
+		}
+	}
+	return n > 0 ? sum/n : std::numeric_limits<double>::quiet_NaN();
+}
+
+double SpikeAnalysis::getMeanFano() const
+{
+	double sum(0.0);
+	int n(0);
+	for (int i(0); i<nb_neurons_; ++i){
+		if (nb_spikes_[i] > bin_count_[i]){
+			sum += getFano(i);
+			++n;
+		}
+	}
+	return n > 0 ? sum/n : std::numeric_limits<double>::quiet_NaN();
+}
+
+double SpikeAnalysis::getSynchrony() const
+{
+	//only the complete bins are compared
+	const unsigned int nb_complete(nb_steps_/bin_steps_);
+	const double n(nb_complete);
+	double neurons_variance(0.0);
+	for (int i(0); i<nb_neurons_ and nb_complete > 0; ++i){
+		const double mean((nb_spikes_[i] - bin_count_[i])/n);
+		neurons_variance += std::max(0.0, count_sum2_[i]/n - mean*mean);
+	}
+	if (neurons_variance <= 0.0){
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	//the population is described by the mean number of spikes of the neurons in each bin
+	double sum(0.0), sum2(0.0);
+	for (unsigned int b(0); b<nb_complete; ++b){
+		const double population(double(bins_[b])/nb_neurons_);
+		sum += population;
+		sum2 += population*population;
+	}
+	const double mean(sum/n);
+	const double population_variance(std::max(0.0, sum2/n - mean*mean));
+	return population_variance/(neurons_variance/nb_neurons_);
+}
+
+void SpikeAnalysis::writePopulation(std::string const& file_name) const
+{
+	std::ofstream file (file_name.c_str());
+	assert(not file.fail()); //check if the file opens correctly
+	file << "time_ms,spikes,rate_hz\n";
+	for (int b(0); b<getNumberBins(); ++b){
+		file << b*bin_steps_*dt_ << ',' << bins_[b] << ',' << getPopulationRate(b) << '\n';
+	}
+}
+
+void SpikeAnalysis::writeNeurons(std::string const& file_name) const
+{
+	std::ofstream file (file_name.c_str());
+	assert(not file.fail()); //check if the file opens correctly
+	file << "neuron,spikes,rate_hz,cv_isi,fano\n";
+	for (int i(0); i<nb_neurons_; ++i){
+		file << i << ',' << nb_spikes_[i] << ',' << getRate(i) << ',' << getCV(i) << ',' << getFano(i) << '\n';
+	}
+}
+
+void SpikeAnalysis::closeBin(int i)
+{
+	count_sum2_[i] += double(bin_count_[i])*bin_count_[i];
+	bin_count_[i] = 0;
+}
+
+SpikeAnalysis::~SpikeAnalysis()
+{}
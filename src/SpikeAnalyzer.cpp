@@ -0,0 +1,76 @@
+#include "SpikeAnalysis.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+
+//Compute the statistics of a binary spike file and write them in two CSV files
+//usage: ./SpikeAnalyzer [binary file] [bin width in ms] [duration in ms] [prefix of the CSV files]
+//by default the duration ends with the last spike, it must be given if the file has no spike
+
+/*!
+ * @brief Read a number of the command line
+ * @details An error is printed if the argument isn't a number or if it's below the minimum.
+ *
+ * @param name : a string indicating the name of the argument, for the error message
+ * @param text : the argument
+ * @param minimum : a double indicating the smallest value accepted
+ * @param exclusive : a boolean, true if the minimum itself is refused
+ * @param value : a double receiving the number
+ * @return A boolean: true if the number is correct
+ */
+static bool readNumber(std::string const& name, const char* text, double minimum, bool exclusive, double& value)
+{
+	char* end(nullptr);
+	value = std::strtod(text, &end);
+	if (end == text or *end != '\0' or not std::isfinite(value) or value < minimum or (exclusive and value == minimum)){
+		std::cerr << "The " << name << " must be a number " << (exclusive ? "above " : "of at least ") << minimum
+				  << ": " << text << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	std::string binary_name ("Spike_time.bin");
+	double bin_width (1.0);
+	double duration (0.0);
+	std::string prefix ("Spike_time");
+	if (argc > 1){
+		binary_name = argv[1];
+	}
+	if (argc > 2 and not readNumber("bin width", argv[2], 0.0, true, bin_width)){
+		return 1;
+	}
+	if (argc > 3 and not readNumber("duration", argv[3], 0.0, false, duration)){
+		return 1;
+	}
+	if (argc > 4){
+		prefix = argv[4];
+	}
+
+	SpikeReader reader (binary_name);
+	const SpikeFileHeader header (reader.getHeader());
+	SpikeAnalysis analysis (header.nb_neurons, bin_width, header.h);
+	analysis.add(reader);
+
+	unsigned int nb_steps (std::round(duration/header.h));
+	//the file doesn't contain the duration, without spike it can't be found
+	if (reader.getNumberSpikes() == 0 and nb_steps == 0){
+		std::cerr << "The file " << binary_name << " has no spike, the duration must be given" << std::endl;
+		return 1;
+	}
+	if (reader.getNumberSpikes() > 0 and nb_steps <= reader.getSpike(reader.getNumberSpikes()-1).step){
+		nb_steps = reader.getSpike(reader.getNumberSpikes()-1).step + 1;
+	}
+	analysis.finish(nb_steps);
+	analysis.writePopulation(prefix + "_population.csv");
+	analysis.writeNeurons(prefix + "_neurons.csv");
+
+	std::cout << reader.getNumberSpikes() << " spikes of " << header.nb_neurons << " neurons (g = " << header.g
+			  << ", nu_ext/nu_thr = " << header.pois << ")" << std::endl;
+	std::cout << "Mean rate: " << analysis.getMeanRate() << " Hz, mean CV: " << analysis.getMeanCV()
+			  << ", mean Fano factor: " << analysis.getMeanFano() << std::endl;
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include "SpikeRecorder.hpp"
+#include <iostream>
+#include <string>
+
+//Convert a binary spike file in the text file read by Graphs.py
+//usage: ./SpikeConverter [binary file] [text file]
+
+int main(int argc, char** argv)
+{
+	std::string binary_name ("Spike_time.bin");
+	std::string text_name ("Spike_time.txt");
+	if (argc > 1){
+		binary_name = argv[1];
+	}
+	if (argc > 2){
+		text_name = argv[2];
+	}
+	std::cout << SpikeRecorder::convertToText(binary_name, text_name) << " spikes written in " << text_name << std::endl;
+	return 0;
+}
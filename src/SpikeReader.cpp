@@ -0,0 +1,63 @@
+#include "SpikeReader.hpp"
+#include <cstring>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+SpikeReader::SpikeReader(std::string const& file_name)
+: file_(::open(file_name.c_str(), O_RDONLY)), size_(0), data_(nullptr), nb_spikes_(0)
+{
+	assert(file_ >= 0); //check if the file opens correctly
+	struct stat status;
+	fstat(file_, &status);
+	size_ = status.st_size;
+	assert(size_ >= sizeof(SpikeFileHeader));
+
+	void* data(mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0));
+	assert(data != MAP_FAILED);
+	data_ = static_cast<const char*>(data);
+	//the file is read from the beginning to the end
+	madvise(data, size_, MADV_SEQUENTIAL);
+
+	std::memcpy(&header_, data_, sizeof(header_));
+	assert(std::memcmp(header_.magic, "BRUNELSP", 8) == 0 and header_.version == 1);
+	//if the simulation didn't end, the number of spikes is given by the size of the file
+	nb_spikes_ = (size_ - sizeof(SpikeFileHeader))/(2*sizeof(std::uint32_t));
+	if (header_.nb_spikes != 0){
+		assert(header_.nb_spikes <= nb_spikes_);
+		nb_spikes_ = header_.nb_spikes;
+	}
+	header_.nb_spikes = nb_spikes_;
+}
+
+SpikeFileHeader SpikeReader::getHeader() const
+{
+	return header_;
+}
+
+std::uint64_t SpikeReader::getNumberSpikes() const
+{
+	return nb_spikes_;
+}
+
+Spike SpikeReader::getSpike(std::uint64_t k) const
+{
+	assert(k < nb_spikes_);
+	const std::uint32_t* records(getRecords());
+	return Spike {records[2*k], int(records[2*k+1])};
+}
+
+const std::uint32_t* SpikeReader::getRecords() const
+{
+	//the header has 48 bytes, so the records are aligned
+	return reinterpret_cast<const std::uint32_t*>(data_ + sizeof(SpikeFileHeader));
+}
+
+SpikeReader::~SpikeReader()
+{
+	munmap(const_cast<char*>(data_), size_);
+	::close(file_);
+}
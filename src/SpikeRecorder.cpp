@@ -0,0 +1,139 @@
+#include "SpikeRecorder.hpp"
+#include <cstring>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+static_assert(sizeof(SpikeFileHeader) == 48, "the header of a spike file has 48 bytes");
+
+constexpr std::size_t SpikeRecorder::max_blocks;
+
+
+SpikeRecorder::SpikeRecorder(std::string const& file_name, int nb_neurons, double g, double pois,
+							 std::size_t block_size)
+: file_(file_name.c_str(), std::ios::binary),
+  block_size_(block_size),
+  closing_(false),
+  closed_(false),
+  nb_spikes_(0)
+{
+	assert(not file_.fail()); //check if the file opens correctly
+	assert(block_size > 0);
+	SpikeFileHeader header;
+	std::memcpy(header.magic, "BRUNELSP", sizeof(header.magic));
+	header.version = 1;
+	header.nb_neurons = nb_neurons;
+	header.h = h;
+	header.g = g;
+	header.pois = pois;
+	header.nb_spikes = 0; //written when the file is closed
+	file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	block_.reserve(2*block_size_);
+	writer_ = std::thread(&SpikeRecorder::write, this);
+}
+
+std::uint64_t SpikeRecorder::getNumberSpikes() const
+{
+	return nb_spikes_;
+}
+
+void SpikeRecorder::record(Spike const& spike)
+{
+	assert(not closed_);
+	block_.push_back(spike.step);
+	block_.push_back(spike.neuron);
+	++nb_spikes_;
+	if (block_.size() >= 2*block_size_){
+		flushBlock();
+	}
+}
+
+void SpikeRecorder::record(std::vector<Spike> const& spikes)
+{
+	for (auto const& spike : spikes){
+		record(spike);
+	}
+}
+
+void SpikeRecorder::close()
+{
+	if (closed_){
+		return;
+	}
+	flushBlock();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		closing_ = true;
+	}
+	ready_.notify_one();
+	writer_.join();
+	//the number of spikes is written in the header
+	file_.seekp(offsetof(SpikeFileHeader, nb_spikes));
+	file_.write(reinterpret_cast<const char*>(&nb_spikes_), sizeof(nb_spikes_));
+	file_.close();
+	closed_ = true;
+}
+
+std::uint64_t SpikeRecorder::convertToText(std::string const& binary_name, std::string const& text_name)
+{
+	std::ifstream binary(binary_name.c_str(), std::ios::binary);
+	assert(not binary.fail());
+	SpikeFileHeader header;
+	binary.read(reinterpret_cast<char*>(&header), sizeof(header));
+	assert(binary.gcount() == sizeof(header) and std::memcmp(header.magic, "BRUNELSP", 8) == 0);
+
+	std::ofstream text(text_name.c_str());
+	assert(not text.fail());
+	//the spikes are read by blocks until the end of the file
+	std::vector<std::uint32_t> block(2*(1 << 16));
+	std::uint64_t nb_spikes(0);
+	do {
+		binary.read(reinterpret_cast<char*>(block.data()), block.size()*sizeof(std::uint32_t));
+		const std::size_t nb_read(binary.gcount()/(2*sizeof(std::uint32_t)));
+		for (std::size_t k(0); k<nb_read; ++k){
+			text << block[2*k] << '\t' << block[2*k+1] << '\n';
+		}
+		nb_spikes += nb_read;
+	} while (binary);
+	return nb_spikes;
+}
+
+void SpikeRecorder::flushBlock()
+{
+	if (block_.empty()){
+		return;
+	}
+	std::vector<std::uint32_t> full;
+	full.reserve(2*block_size_);
+	full.swap(block_);
+	{
+		//the simulation waits if the writer thread is late
+		std::unique_lock<std::mutex> lock(mutex_);
+		space_.wait(lock, [this]{ return full_blocks_.size() < max_blocks; });
+		full_blocks_.push_back(std::move(full));
+	}
+	ready_.notify_one();
+}
+
+void SpikeRecorder::write()
+{
+	while (true){
+		std::vector<std::uint32_t> block;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			ready_.wait(lock, [this]{ return closing_ or not full_blocks_.empty(); });
+			if (full_blocks_.empty()){
+				return; //closing and nothing left to write
+			}
+			block.swap(full_blocks_.front());
+			full_blocks_.pop_front();
+		}
+		space_.notify_one();
+		file_.write(reinterpret_cast<const char*>(block.data()), block.size()*sizeof(std::uint32_t));
+	}
+}
+
+SpikeRecorder::~SpikeRecorder()
+{
+	close();
+}
@@ -0,0 +1,173 @@
+#include <iostream>
+#include "SpikeRecorder.hpp"
+#include "SpikeReader.hpp"
+#include "SpikeAnalysis.hpp"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the binary file contains the header and all the spikes recorded,
+ * also when the spikes fill several blocks
+*/
+
+TEST (SpikeRecorderTest, BinaryFile){
+	{
+		SpikeRecorder recorder ("test_spikes.bin", 12500, 5, 2, 10); //blocks of 10 spikes
+		for (unsigned int t(0); t<100; ++t){
+			recorder.record(Spike {t, int(t*7)});
+		}
+		EXPECT_EQ (100u, recorder.getNumberSpikes());
+	} //the file is closed by the destructor
+
+	std::ifstream file ("test_spikes.bin", std::ios::binary);
+	SpikeFileHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	EXPECT_EQ (0, std::memcmp(header.magic, "BRUNELSP", 8));
+	EXPECT_EQ (1u, header.version);
+	EXPECT_EQ (12500u, header.nb_neurons);
+	EXPECT_EQ (h, header.h);
+	EXPECT_EQ (5.0, header.g);
+	EXPECT_EQ (2.0, header.pois);
+	EXPECT_EQ (100u, header.nb_spikes);
+	//the spikes follow the header in the order they were recorded
+	std::uint32_t spike[2];
+	for (unsigned int t(0); t<100; ++t){
+		file.read(reinterpret_cast<char*>(spike), sizeof(spike));
+		EXPECT_EQ (t, spike[0]);
+		EXPECT_EQ (t*7, spike[1]);
+	}
+	file.read(reinterpret_cast<char*>(spike), sizeof(spike));
+	EXPECT_TRUE (file.eof()); //nothing else in the file
+}
+
+/*
+ * TEST2: Test if the conversion gives the text format read by Graphs.py
+*/
+
+TEST (SpikeRecorderTest, ConvertToText){
+	{
+		SpikeRecorder recorder ("test_spikes.bin", 3, 5, 2);
+		std::vector<Spike> spikes {{924, 0}, {924, 2}, {1100, 1}};
+		recorder.record(spikes);
+	}
+	EXPECT_EQ (3u, SpikeRecorder::convertToText("test_spikes.bin", "test_spikes.txt"));
+	std::ifstream text ("test_spikes.txt");
+	std::string line;
+	std::getline(text, line);
+	EXPECT_EQ ("924\t0", line);
+	std::getline(text, line);
+	EXPECT_EQ ("924\t2", line);
+	std::getline(text, line);
+	EXPECT_EQ ("1100\t1", line);
+	EXPECT_FALSE (std::getline(text, line));
+}
+
+/*
+ * TEST3: Test if the spikes read in the mapped file are the spikes recorded
+*/
+
+TEST (SpikeRecorderTest, Reader){
+	{
+		SpikeRecorder recorder ("test_spikes.bin", 12500, 6, 4, 7);
+		for (unsigned int t(0); t<50; ++t){
+			recorder.record(Spike {t/2, int(t)});
+		}
+	}
+	SpikeReader reader ("test_spikes.bin");
+	EXPECT_EQ (50u, reader.getNumberSpikes());
+	EXPECT_EQ (12500u, reader.getHeader().nb_neurons);
+	EXPECT_EQ (6.0, reader.getHeader().g);
+	for (unsigned int t(0); t<50; ++t){
+		EXPECT_EQ (t/2, reader.getSpike(t).step);
+		EXPECT_EQ (int(t), reader.getSpike(t).neuron);
+	}
+}
+
+/*
+ * TEST4: Test the statistics computed on spikes with known intervals
+*/
+
+TEST (SpikeRecorderTest, Analysis){
+	SpikeAnalysis analysis (3, 1.0); //bins of 10 time steps
+	EXPECT_EQ (10u, analysis.getBinSteps());
+	//neuron 0 spikes regularly every 10 time steps, neuron 1 twice, neuron 2 never
+	for (unsigned int t(0); t<100; t += 10){
+		analysis.add(Spike {t, 0});
+		if (t == 20 or t == 50){
+			analysis.add(Spike {t+1, 1});
+		}
+	}
+	analysis.finish(100); //10 milliseconds
+	EXPECT_EQ (10, analysis.getNumberBins());
+	EXPECT_EQ (1u, analysis.getBinCount(0));
+	EXPECT_EQ (2u, analysis.getBinCount(2));
+	EXPECT_NEAR (1000.0*2/(3*1.0), analysis.getPopulationRate(2), 1e-9);
+	EXPECT_NEAR (1000.0, analysis.getRate(0), 1e-9); //10 spikes in 10 milliseconds
+	EXPECT_NEAR (200.0, analysis.getRate(1), 1e-9);
+	EXPECT_EQ (0.0, analysis.getRate(2));
+	EXPECT_NEAR (0.0, analysis.getCV(0), 1e-9); //regular intervals
+	EXPECT_TRUE (std::isnan(analysis.getCV(1))); //only one interval
+	EXPECT_NEAR (0.0, analysis.getFano(0), 1e-9); //one spike in every bin
+	//neuron 1: 2 bins with 1 spike, 8 with 0: mean 0.2, variance 0.16
+	EXPECT_NEAR (0.16/0.2, analysis.getFano(1), 1e-9);
+	EXPECT_TRUE (std::isnan(analysis.getFano(2)));
+	EXPECT_NEAR (400.0, analysis.getMeanRate(), 1e-9);
+
+	//a recording without spike and without duration has no rate
+	SpikeAnalysis empty (3, 1.0);
+	empty.finish(0);
+	EXPECT_EQ (0, empty.getNumberBins());
+	EXPECT_EQ (0.0, empty.getRate(0));
+	EXPECT_EQ (0.0, empty.getMeanRate());
+}
+
+/*
+ * TEST5: Test the last bin when the duration isn't a multiple of the width of the bins
+*/
+
+TEST (SpikeRecorderTest, PartialBin){
+	SpikeAnalysis analysis (3, 1.0); //bins of 10 time steps
+	//neuron 0 spikes once in each complete bin, neuron 1 only in the last bin of 5 time steps
+	analysis.add(Spike {0, 0});
+	analysis.add(Spike {10, 0});
+	analysis.add(Spike {21, 1});
+	analysis.add(Spike {22, 2});
+	analysis.finish(25);
+	EXPECT_EQ (3, analysis.getNumberBins());
+	EXPECT_NEAR (1000.0*1/(3*1.0), analysis.getPopulationRate(0), 1e-9);
+	EXPECT_NEAR (1000.0*2/(3*0.5), analysis.getPopulationRate(2), 1e-9); //divided by 0.5 millisecond
+	EXPECT_NEAR (1000.0*1/2.5, analysis.getRate(1), 1e-9);
+	//the shorter bin isn't compared with the complete ones
+	EXPECT_NEAR (0.0, analysis.getFano(0), 1e-9);
+	EXPECT_TRUE (std::isnan(analysis.getFano(1)));
+	EXPECT_NEAR (0.0, analysis.getMeanFano(), 1e-9);
+	EXPECT_TRUE (std::isnan(analysis.getSynchrony())); //neuron 0 is regular in the complete bins
+}
+
+/*
+ * TEST6: Test the synchrony index when the neurons spike together and when they spike at different times
+*/
+
+TEST (SpikeRecorderTest, Synchrony){
+	SpikeAnalysis together (4, 1.0), apart (4, 1.0);
+	for (unsigned int t(0); t<200; t += 20){
+		for (int i(0); i<4; ++i){
+			together.add(Spike {t, i});
+			apart.add(Spike {t + 5*i, i}); //each neuron in a different bin
+		}
+	}
+	together.finish(200);
+	apart.finish(200);
+	EXPECT_NEAR (1.0, together.getSynchrony(), 1e-9);
+	EXPECT_NEAR (0.0, apart.getSynchrony(), 1e-9); //the population rate is constant over each period of 2 bins
+}
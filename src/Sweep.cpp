@@ -0,0 +1,141 @@
+#include "Sweep.hpp"
+#include "SpikeRecorder.hpp"
+#include "SpikeAnalysis.hpp"
+#include "PopulationMonitor.hpp"
+#include "ThreadPool.hpp"
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+
+constexpr double Sweep::bin_width;
+constexpr double Sweep::synchrony_threshold;
+constexpr double Sweep::cv_threshold;
+
+Sweep::Sweep(Parameters const& parameters, bool record)
+: parameters_(parameters),
+  record_(record)
+{
+	for (auto const& g : parameters_.g){
+		for (auto const& rate : parameters_.rate){
+			points_.push_back(SweepPoint {g, rate, 0, 0.0, 0.0, 0.0, ""});
+		}
+	}
+}
+
+void Sweep::run()
+{
+	//the connections are created once, all the networks read the same ones
+	std::shared_ptr<Connectivity> connectivity(std::make_shared<Connectivity>(parameters_.getNumberNeurons()));
+	connectivity->addRandomConnections(parameters_.nb_excitatory, parameters_.conn_e, parameters_.conn_i, parameters_.seed,
+										parameters_.threads);
+	if (parameters_.getMinDelay() != D or parameters_.getMaxDelay() != D){
+		connectivity->addRandomDelays(parameters_.getMinDelay(), parameters_.getMaxDelay(), parameters_.seed + 1);
+	}
+	connectivity_ = connectivity;
+
+	//the points are shared between the threads, the threads left update the networks
+	const int nb_parallel(std::min<int>(parameters_.threads, points_.size()));
+	const int nb_threads(std::max(1, parameters_.threads/nb_parallel));
+	ThreadPool pool (nb_parallel);
+	pool.run(points_.size(), [=](int k){ runPoint(k, nb_threads); });
+}
+
+std::shared_ptr<const Connectivity> Sweep::getConnectivity() const
+{
+	return connectivity_;
+}
+
+int Sweep::getNumberPoints() const
+{
+	return points_.size();
+}
+
+SweepPoint const& Sweep::getPoint(int k) const
+{
+	return points_[k];
+}
+
+void Sweep::write(std::string const& file_name) const
+{
+	std::ofstream file (file_name.c_str());
+	assert(not file.fail()); //check if the file opens correctly
+	file << "g,rate,spikes,rate_hz,synchrony,cv_isi,regime\n";
+	for (auto const& point : points_){
+		file << point.g << ',' << point.rate << ',' << point.nb_spikes << ',' << point.mean_rate << ','
+			 << point.synchrony << ',' << point.cv << ',' << point.regime << '\n';
+	}
+}
+
+std::string Sweep::classify(double mean_rate, double synchrony, double cv)
+{
+	if (not (mean_rate >= 0.1)){
+		return "quiescent";
+	}
+	std::string regime (synchrony > synchrony_threshold ? "S" : "A");
+	//when the neurons don't spike enough the CV is NaN and they are counted as regular
+	return regime + (cv > cv_threshold ? "I" : "R");
+}
+
+void Sweep::runPoint(int k, int nb_threads)
+{
+	SweepPoint& point (points_[k]);
+	//each point has its own neurons and its own noises, the seed of the noises is the same for all the points
+	Network network (parameters_.nb_excitatory, parameters_.nb_inhibitory, parameters_.noise_seed);
+	network.setAmplitude(parameters_.J);
+	network.setNumberThreads(nb_threads);
+	network.setConnectivity(connectivity_);
+
+	std::unique_ptr<SpikeRecorder> recorder;
+	if (record_){
+		std::ostringstream file_name;
+		file_name << parameters_.output << "_g" << point.g << "_rate" << point.rate << ".bin";
+		recorder.reset(new SpikeRecorder(file_name.str(), network.getNumberNeurons(), point.g, point.rate));
+	}
+	SpikeAnalysis analysis (network.getNumberNeurons(), bin_width);
+	//the rates of the populations are written during the simulation, without the spikes
+	std::unique_ptr<PopulationMonitor> monitor;
+	if (parameters_.monitor > 0.0){
+		std::ostringstream file_name;
+		file_name << parameters_.output << "_g" << point.g << "_rate" << point.rate << "_population.csv";
+		monitor.reset(new PopulationMonitor(network.getNumberNeurons(), network.getNumberExcitatory(), parameters_.monitor,
+											file_name.str()));
+	}
+
+	const int end_time(parameters_.getNumberSteps()*N);
+	int simulation_time(t_start);
+	const double noise(parameters_.getPoissonMean(point.rate));
+	while (simulation_time < end_time){
+		const int nb_steps(std::min({parameters_.window, network.getMinDelay(), (end_time - simulation_time)/N}));
+		network.update(point.g, noise, nb_steps);
+		std::vector<Spike> const& spikes(network.getLastSpikes());
+		//the spikes are analysed as soon as they are known, they are never kept
+		for (auto const& spike : spikes){
+			analysis.add(spike);
+		}
+		if (recorder){
+			recorder->record(spikes);
+		}
+		simulation_time += nb_steps*N;
+		if (monitor){
+			monitor->add(spikes, simulation_time, network.getMeanV_membrane());
+		}
+	}
+	analysis.finish(parameters_.getNumberSteps());
+	if (monitor){
+		monitor->finish(end_time);
+	}
+
+	for (int i(0); i<network.getNumberNeurons(); ++i){
+		point.nb_spikes += analysis.getNumberSpikes(i);
+	}
+	point.mean_rate = analysis.getMeanRate();
+	point.synchrony = analysis.getSynchrony();
+	point.cv = analysis.getMeanCV();
+	point.regime = classify(point.mean_rate, point.synchrony, point.cv);
+}
+
+Sweep::~Sweep()
+{}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include "Sweep.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+//Run all the tests of gtest
+
+int main(int argc, char**argv){
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+/*
+ * TEST1: Test if the points simulated at the same time with the shared connections give the same spikes
+ * as a network simulated alone with the same connections and the same noises
+*/
+
+TEST (SweepTest, SameAsNetwork){
+	Parameters parameters;
+	parameters.nb_excitatory = 800;
+	parameters.nb_inhibitory = 200;
+	parameters.conn_e = 80;
+	parameters.conn_i = 20;
+	parameters.g = {3.0, 5.0};
+	parameters.rate = {2.0};
+	parameters.duration = 100.0;
+	parameters.threads = 4;
+	parameters.seed = 11;
+	parameters.noise_seed = 12;
+	Sweep sweep (parameters, false);
+	ASSERT_EQ (2, sweep.getNumberPoints());
+	sweep.run();
+
+	for (int k(0); k<2; ++k){
+		Network network (800, 200, 12);
+		network.setConnectivity(sweep.getConnectivity());
+		unsigned int nb_spikes(0);
+		for (int t(0); t<1000; t += D){
+			network.update(parameters.g[k], 2.0, std::min(D, 1000-t));
+		}
+		for (int i(0); i<1000; ++i){
+			nb_spikes += network.getNumberSpikes(i);
+		}
+		SweepPoint const& point (sweep.getPoint(k));
+		EXPECT_EQ (parameters.g[k], point.g);
+		EXPECT_EQ (nb_spikes, point.nb_spikes);
+		EXPECT_NEAR (nb_spikes/(1000*0.1), point.mean_rate, 1e-9); //spikes per neuron in 100 milliseconds
+		EXPECT_FALSE (point.regime.empty());
+	}
+	//more inhibition, less spikes
+	EXPECT_GT (sweep.getPoint(0).nb_spikes, sweep.getPoint(1).nb_spikes);
+}
+
+/*
+ * TEST2: Test the regimes found from the statistics
+*/
+
+TEST (SweepTest, Classify){
+	EXPECT_EQ ("quiescent", Sweep::classify(0.0, std::numeric_limits<double>::quiet_NaN(), 0.0));
+	EXPECT_EQ ("SR", Sweep::classify(300.0, 0.8, 0.1));
+	EXPECT_EQ ("SI", Sweep::classify(50.0, 0.3, 0.9));
+	EXPECT_EQ ("AI", Sweep::classify(10.0, 0.01, 0.9));
+	EXPECT_EQ ("AR", Sweep::classify(10.0, 0.01, std::numeric_limits<double>::quiet_NaN()));
+}
@@ -0,0 +1,81 @@
+#include "ThreadPool.hpp"
+#include <cassert>
+
+
+ThreadPool::ThreadPool(int nb_threads)
+: task_(nullptr), nb_tasks_(0), next_task_(0), running_(0), generation_(0), stop_(false)
+{
+	assert(nb_threads >= 1);
+	//the calling thread is one of the threads executing the tasks
+	for (int i(1); i<nb_threads; ++i){
+		workers_.push_back(std::thread(&ThreadPool::work, this));
+	}
+}
+
+int ThreadPool::getNumberThreads() const
+{
+	return workers_.size() + 1;
+}
+
+void ThreadPool::run(int nb_tasks, std::function<void(int)> const& task)
+{
+	if (workers_.empty()){
+		for (int i(0); i<nb_tasks; ++i){
+			task(i);
+		}
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		task_ = &task;
+		nb_tasks_ = nb_tasks;
+		next_task_ = 0;
+		running_ = workers_.size();
+		++generation_;
+	}
+	start_.notify_all();
+	executeTasks();
+	//wait until the other threads have finished their last task
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_.wait(lock, [this]{ return running_ == 0; });
+	task_ = nullptr;
+}
+
+void ThreadPool::executeTasks()
+{
+	for (int i(next_task_++); i<nb_tasks_; i = next_task_++){
+		(*task_)(i);
+	}
+}
+
+void ThreadPool::work()
+{
+	unsigned long generation(0);
+	while (true){
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			start_.wait(lock, [&]{ return stop_ or generation_ != generation; });
+			if (stop_){
+				return;
+			}
+			generation = generation_;
+		}
+		executeTasks();
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (--running_ == 0){
+			done_.notify_one();
+		}
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	start_.notify_all();
+	for (auto& w : workers_){
+		w.join();
+	}
+}
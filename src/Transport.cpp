@@ -0,0 +1,115 @@
+#include "Transport.hpp"
+#include <cassert>
+
+
+Transport::~Transport()
+{}
+
+std::vector<std::shared_ptr<Transport>> LocalTransport::createGroup(int nb_ranks)
+{
+	assert(nb_ranks >= 1);
+	std::shared_ptr<Group> group(std::make_shared<Group>());
+	group->spikes.assign(nb_ranks, nullptr);
+	group->nb_waiting = 0;
+	group->generation = 0;
+	std::vector<std::shared_ptr<Transport>> transports;
+	for (int rank(0); rank<nb_ranks; ++rank){
+		transports.push_back(std::shared_ptr<Transport>(new LocalTransport(group, rank)));
+	}
+	return transports;
+}
+
+LocalTransport::LocalTransport(std::shared_ptr<Group> group, int rank)
+: group_(group),
+  rank_(rank)
+{}
+
+int LocalTransport::getRank() const
+{
+	return rank_;
+}
+
+int LocalTransport::getNumberRanks() const
+{
+	return group_->spikes.size();
+}
+
+void LocalTransport::exchange(std::vector<Spike> const& sent, std::vector<Spike>& received)
+{
+	group_->spikes[rank_] = &sent;
+	barrier();
+	//all the spikes are published, they are read directly in the vectors of the other ranks
+	received.clear();
+	for (auto const& spikes : group_->spikes){
+		received.insert(received.end(), spikes->begin(), spikes->end());
+	}
+	//the vectors must stay unchanged until every rank has copied them
+	barrier();
+}
+
+void LocalTransport::barrier()
+{
+	std::unique_lock<std::mutex> lock(group_->mutex);
+	const unsigned long generation(group_->generation);
+	if (++group_->nb_waiting == getNumberRanks()){
+		group_->nb_waiting = 0;
+		++group_->generation;
+		group_->arrived.notify_all();
+	} else {
+		group_->arrived.wait(lock, [&]{ return group_->generation != generation; });
+	}
+}
+
+#ifdef USE_MPI
+
+MpiTransport::MpiTransport(MPI_Comm communicator)
+: communicator_(communicator),
+  initialized_(false)
+{
+	int initialized(0);
+	MPI_Initialized(&initialized);
+	if (not initialized){
+		MPI_Init(nullptr, nullptr);
+		initialized_ = true;
+	}
+	counts_.assign(getNumberRanks(), 0);
+	displacements_.assign(getNumberRanks(), 0);
+}
+
+int MpiTransport::getRank() const
+{
+	int rank(0);
+	MPI_Comm_rank(communicator_, &rank);
+	return rank;
+}
+
+int MpiTransport::getNumberRanks() const
+{
+	int nb_ranks(1);
+	MPI_Comm_size(communicator_, &nb_ranks);
+	return nb_ranks;
+}
+
+void MpiTransport::exchange(std::vector<Spike> const& sent, std::vector<Spike>& received)
+{
+	//the spikes are sent as bytes, all the ranks have the same representation of a Spike
+	int bytes(sent.size()*sizeof(Spike));
+	MPI_Allgather(&bytes, 1, MPI_INT, counts_.data(), 1, MPI_INT, communicator_);
+	int total(0);
+	for (std::size_t r(0); r<counts_.size(); ++r){
+		displacements_[r] = total;
+		total += counts_[r];
+	}
+	received.resize(total/sizeof(Spike));
+	MPI_Allgatherv(const_cast<Spike*>(sent.data()), bytes, MPI_BYTE, received.data(), counts_.data(),
+				   displacements_.data(), MPI_BYTE, communicator_);
+}
+
+MpiTransport::~MpiTransport()
+{
+	if (initialized_){
+		MPI_Finalize();
+	}
+}
+
+#endif
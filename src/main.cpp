@@ -1,20 +1,29 @@
 #include "Neuron.hpp"
 #include "Simulation.hpp"
+#include "Parameters.hpp"
 #include <iostream>
 #include <cmath>
 #include <fstream>
+#include <string>
+#include <stdexcept>
 
-int main()
+int main(int argc, char** argv)
 {
-	//uncomment the simulate one specific case
-	Simulation sim;
-	//sim.oneNeuronSimulation();
-	//sim.twoNeruonsSimulation();
-	sim.networkSimulation(5,2);
-	//sim.plotGraph_A();
-	//sim.plotGraph_B();
-	//sim.plotGraph_C();
-	//sim.plotGraph_D();
+	//the simulation is chosen by the parameters given on the command line, see --help
+	Parameters parameters;
+	if (argc > 1 and std::string(argv[1]) == "--help"){
+		std::cout << Parameters::getUsage();
+		return 0;
+	}
+	try {
+		parameters.readArguments(argc, argv);
+	} catch (std::invalid_argument const& error){
+		std::cerr << error.what() << std::endl << Parameters::getUsage();
+		return 1;
+	}
+	//without parameters, the network is simulated with g = 5 and nu_ext/nu_thr = 2
+	Simulation sim (parameters);
+	sim.run();
 	std::cout << "Simulation done" << std::endl;
 	return 0;
 }